@@ -351,6 +351,33 @@ var authCommandsLib = {
                 }
             ]
         },
+        {
+            testname: "aggregate_queryShapeStats",
+            command: {aggregate: "foo", pipeline: [{$queryShapeStats: {}}]},
+            skipSharded: true,
+            setup: function (db) {
+                db.createCollection("foo");
+            },
+            teardown: function (db) {
+                db.foo.drop();
+            },
+            testcases: [
+                {
+                    runOnDb: firstDbName,
+                    roles: roles_dbAdmin,
+                    privileges: [
+                        { resource: {db: firstDbName, collection: "foo"}, actions: ["planCacheRead"] }
+                    ],
+                },
+                {
+                    runOnDb: secondDbName,
+                    roles: roles_dbAdminAny,
+                    privileges: [
+                        { resource: {db: secondDbName, collection: "foo"}, actions: ["planCacheRead"] }
+                    ],
+                },
+            ]
+        },
         {
             testname: "appendOplogNote",
             command: {appendOplogNote: 1, data: {a: 1}},
@@ -1994,6 +2021,29 @@ var authCommandsLib = {
                 },
             ]
         },
+        {
+            testname: "planCacheResetQueryShapeStats",
+            command: {planCacheResetQueryShapeStats: "x"},
+            skipSharded: true,
+            setup: function (db) { db.x.save( {} ); },
+            teardown: function (db) { db.x.drop(); },
+            testcases: [
+                {
+                    runOnDb: firstDbName,
+                    roles: roles_dbAdmin,
+                    privileges: [
+                        { resource: {db: firstDbName, collection: "x"}, actions: ["planCacheWrite"] }
+                    ],
+                },
+                {
+                    runOnDb: secondDbName,
+                    roles: roles_dbAdminAny,
+                    privileges: [
+                        { resource: {db: secondDbName, collection: "x"}, actions: ["planCacheWrite"] }
+                    ],
+                },
+            ]
+        },
         {
             testname: "ping",
             command: {ping: 1},
@@ -0,0 +1,81 @@
+// Tests the per-query-shape execution statistics reported by $queryShapeStats.
+(function() {
+    "use strict";
+
+    var colName = "jstests_query_shape_stats";
+    var col = db[colName];
+    col.drop();
+
+    var getShapeStats = function(op, query) {
+        var stats = col.aggregate([{$queryShapeStats: {}}]).toArray();
+        for (var i = 0; i < stats.length; ++i) {
+            if (stats[i].op === op && bsonWoCompare(stats[i].shape.query, query) === 0) {
+                return stats[i];
+            }
+        }
+
+        return undefined;
+    };
+
+    assert.writeOK(col.insert({a: 1, b: 1}));
+    assert.writeOK(col.insert({a: 2, b: 2}));
+    assert.writeOK(col.insert({a: 3, b: 3}));
+    assert.commandWorked(col.createIndex({a: 1}));
+
+    //
+    // Queries with the same shape are aggregated together.
+    //
+    assert.eq(1, col.find({a: 1}).itcount());
+    assert.eq(1, col.find({a: 2}).itcount());
+    var stats = getShapeStats("find", {a: 1});
+    assert.neq(undefined, stats);
+    assert.eq(2, stats.execCount, tojson(stats));
+    assert.eq(2, stats.nReturned, tojson(stats));
+    assert.eq(2, stats.keysExamined, tojson(stats));
+    assert.gte(stats.latencyMicros.max, 0, tojson(stats));
+    assert.gte(stats.latencyMicros.total, stats.latencyMicros.max, tojson(stats));
+    var histogramCount = 0;
+    stats.latencyMicros.histogram.forEach(function(bucket) {
+        histogramCount += bucket.count;
+    });
+    assert.eq(stats.execCount, histogramCount, tojson(stats));
+
+    //
+    // getMore batches are recorded separately from the initial batch of a find.
+    //
+    assert.eq(3, col.find({a: {$gte: 1}}).batchSize(1).itcount());
+    stats = getShapeStats("find", {a: {$gte: 1}});
+    assert.neq(undefined, stats);
+    assert.eq(1, stats.execCount, tojson(stats));
+    var getMoreStats = getShapeStats("getMore", {a: {$gte: 1}});
+    assert.neq(undefined, getMoreStats);
+    assert.gte(getMoreStats.execCount, 2, tojson(getMoreStats));
+    assert.eq(0, getMoreStats.planCacheHits, tojson(getMoreStats));
+    assert.eq(3, stats.nReturned + getMoreStats.nReturned, tojson(getMoreStats));
+
+    //
+    // Updates and deletes are tracked separately from finds.
+    //
+    assert.writeOK(col.update({b: 3}, {$set: {c: 1}}));
+    stats = getShapeStats("update", {b: 3});
+    assert.neq(undefined, stats);
+    assert.eq(1, stats.execCount, tojson(stats));
+    assert.eq(undefined, getShapeStats("find", {b: 3}));
+
+    assert.writeOK(col.remove({b: 3}));
+    stats = getShapeStats("delete", {b: 3});
+    assert.neq(undefined, stats);
+    assert.eq(1, stats.execCount, tojson(stats));
+
+    //
+    // The statistics can be reset.
+    //
+    assert.commandWorked(db.runCommand({planCacheResetQueryShapeStats: colName}));
+    assert.eq(0, col.aggregate([{$queryShapeStats: {}}]).itcount());
+
+    //
+    // $queryShapeStats must be given an empty specification.
+    //
+    assert.commandFailedWithCode(
+        db.runCommand({aggregate: colName, pipeline: [{$queryShapeStats: {a: 1}}]}), 34433);
+})();
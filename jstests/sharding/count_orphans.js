@@ -0,0 +1,90 @@
+//
+// Tests that count through mongos leaves out orphaned documents on the shards when
+// internalQueryCountFilterOrphans is enabled, both when the shard key index can answer the
+// predicate and when every matching document has to be filtered by shard ownership.
+//
+
+(function() {
+"use strict";
+
+var st = new ShardingTest({shards: 2, mongos: 1});
+
+var mongos = st.s0;
+var admin = mongos.getDB("admin");
+var testDB = mongos.getDB("test");
+var shards = mongos.getCollection("config.shards").find().sort({_id: 1}).toArray();
+
+assert.commandWorked(admin.runCommand({enableSharding: "test"}));
+st.ensurePrimaryShard("test", shards[0]._id);
+
+[st.shard0, st.shard1].forEach(function(shard) {
+    assert.commandWorked(
+        shard.adminCommand({setParameter: 1, internalQueryCountFilterOrphans: true}));
+});
+
+//
+// Ranged shard key: [MinKey, 0) lives on shard0, [0, MaxKey) on shard1.
+//
+
+var coll = testDB.ranged;
+assert.commandWorked(admin.runCommand({shardCollection: coll.getFullName(), key: {_id: 1}}));
+assert.commandWorked(admin.runCommand({split: coll.getFullName(), middle: {_id: 0}}));
+assert.commandWorked(admin.runCommand(
+    {moveChunk: coll.getFullName(), find: {_id: 0}, to: shards[1]._id, _waitForDelete: true}));
+
+for (var i = -10; i < 10; i++) {
+    assert.writeOK(coll.insert({_id: i, x: i % 2}));
+}
+
+// Orphans: documents stored directly on the shard which does not own their range.
+var shard0Coll = st.shard0.getCollection(coll.getFullName());
+var shard1Coll = st.shard1.getCollection(coll.getFullName());
+for (var i = 100; i < 105; i++) {
+    assert.writeOK(shard0Coll.insert({_id: i, x: 1}));
+}
+for (var i = -104; i < -100; i++) {
+    assert.writeOK(shard1Coll.insert({_id: i, x: 1}));
+}
+
+// Empty predicate, counted over the owned ranges of the shard key index.
+assert.eq(20, coll.count());
+
+// Predicate mapping to a single interval of the shard key index.
+assert.eq(10, coll.count({_id: {$gte: -5, $lt: 5}}));
+assert.eq(0, coll.count({_id: {$gte: 100}}));
+
+// Predicate which the shard key index cannot answer, filtered by shard ownership.
+assert.eq(10, coll.count({x: 1}));
+
+// With the parameter off, the orphans are counted as before.
+[st.shard0, st.shard1].forEach(function(shard) {
+    assert.commandWorked(
+        shard.adminCommand({setParameter: 1, internalQueryCountFilterOrphans: false}));
+});
+assert.eq(29, coll.count());
+[st.shard0, st.shard1].forEach(function(shard) {
+    assert.commandWorked(
+        shard.adminCommand({setParameter: 1, internalQueryCountFilterOrphans: true}));
+});
+
+//
+// Hashed shard key.
+//
+
+var hashedColl = testDB.hashed;
+assert.commandWorked(admin.runCommand(
+    {shardCollection: hashedColl.getFullName(), key: {a: "hashed"}, numInitialChunks: 4}));
+
+for (var i = 0; i < 50; i++) {
+    assert.writeOK(hashedColl.insert({a: i}));
+}
+
+// Store the same document directly on both shards. Exactly one of the copies is an orphan.
+assert.writeOK(st.shard0.getCollection(hashedColl.getFullName()).insert({a: 1000}));
+assert.writeOK(st.shard1.getCollection(hashedColl.getFullName()).insert({a: 1000}));
+
+assert.eq(51, hashedColl.count());
+assert.eq(1, hashedColl.count({a: 1000}));
+
+st.stop();
+})();
@@ -170,7 +170,7 @@ protected:
                 continue;
             }
 
-            m->startOrContinueRefresh().refreshAll();
+            m->refreshAllInParallel();
 
             if (!m->isSetUsable()) {
                 log() << "Stopping periodic monitoring of set " << m->getName()
@@ -324,6 +324,31 @@ Refresher ReplicaSetMonitor::startOrContinueRefresh() {
     return out;
 }
 
+void ReplicaSetMonitor::refreshAllInParallel() {
+    // Create all the Refreshers up front, so that they are guaranteed to join the same round
+    // instead of some of them starting a new one after the first finishes.
+    std::vector<Refresher> refreshers;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_state->mutex);
+        const size_t numHosts = std::max(_state->nodes.size(), _state->seedNodes.size());
+        for (size_t i = 0; i < std::max<size_t>(numHosts, 1); i++) {
+            refreshers.push_back(Refresher(_state));
+        }
+        DEV _state->checkInvariants();
+    }
+
+    std::vector<stdx::thread> threads;
+    for (size_t i = 1; i < refreshers.size(); i++) {
+        threads.emplace_back([&refreshers, i] { refreshers[i].refreshAll(); });
+    }
+
+    refreshers[0].refreshAll();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
 void ReplicaSetMonitor::failedHost(const HostAndPort& host) {
     stdx::lock_guard<stdx::mutex> lk(_state->mutex);
     Node* node = _state->findNode(host);
@@ -96,6 +96,16 @@ public:
      */
     Refresher startOrContinueRefresh();
 
+    /**
+     * Contacts every host of the set, with one thread per host so that unreachable hosts are
+     * waited on concurrently rather than one after the other. All threads participate in the same
+     * refresh round, so callers of getHostOrRefresh joining it return as soon as a suitable host
+     * replies. Blocks until the round is complete.
+     *
+     * This is intended to be called periodically from a background thread.
+     */
+    void refreshAllInParallel();
+
     /**
      * Notifies this Monitor that a host has failed and should be considered down.
      *
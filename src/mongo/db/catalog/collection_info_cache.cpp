@@ -39,8 +39,11 @@
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index_legacy.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/explain.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/planner_ixselect.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/service_context.h"
 #include "mongo/util/clock_source.h"
 #include "mongo/util/debug_util.h"
@@ -53,7 +56,9 @@ CollectionInfoCache::CollectionInfoCache(Collection* collection)
       _keysComputed(false),
       _planCache(new PlanCache(collection->ns().ns())),
       _querySettings(new QuerySettings()),
-      _indexUsageTracker(getGlobalServiceContext()->getClockSource()) {}
+      _indexUsageTracker(getGlobalServiceContext()->getClockSource()),
+      _queryShapeStatsTracker(getGlobalServiceContext()->getClockSource(),
+                              std::max(0, internalQueryShapeStatsMaxEntries.load())) {}
 
 
 const UpdateIndexData& CollectionInfoCache::getIndexKeys(OperationContext* txn) const {
@@ -127,6 +132,35 @@ void CollectionInfoCache::notifyOfQuery(OperationContext* txn,
     }
 }
 
+void CollectionInfoCache::notifyOfQueryShapeExecution(
+    CollectionQueryShapeStatsTracker::OpType opType,
+    const CanonicalQuery* cq,
+    const PlanSummaryStats& summaryStats,
+    long long latencyMicros) {
+    if (!cq || internalQueryShapeStatsMaxEntries.load() <= 0) {
+        return;
+    }
+
+    CollectionQueryShapeStatsTracker::ExecutionStats stats;
+    stats.latencyMicros = latencyMicros;
+    stats.keysExamined = summaryStats.totalKeysExamined;
+    stats.docsExamined = summaryStats.totalDocsExamined;
+    stats.nReturned = summaryStats.nReturned;
+    stats.fromPlanCache = summaryStats.fromPlanCache;
+
+    const PlanCacheKey shapeKey = _planCache->computeKey(*cq);
+    _queryShapeStatsTracker.recordExecution(opType,
+                                            shapeKey,
+                                            [cq] {
+                                                const auto& parsed = cq->getParsed();
+                                                return BSON("query" << cq->getQueryObj() << "sort"
+                                                                    << parsed.getSort()
+                                                                    << "projection"
+                                                                    << parsed.getProj());
+                                            },
+                                            stats);
+}
+
 void CollectionInfoCache::clearQueryCache() {
     LOG(1) << _collection->ns().ns() << ": clearing plan cache - collection info cache reset";
     if (NULL != _planCache.get()) {
@@ -210,4 +244,13 @@ void CollectionInfoCache::rebuildIndexData(OperationContext* txn) {
 CollectionIndexUsageMap CollectionInfoCache::getIndexUsageStats() const {
     return _indexUsageTracker.getUsageStats();
 }
+
+std::vector<CollectionQueryShapeStatsTracker::ShapeStats> CollectionInfoCache::getQueryShapeStats()
+    const {
+    return _queryShapeStatsTracker.getStats();
+}
+
+void CollectionInfoCache::resetQueryShapeStats() {
+    _queryShapeStatsTracker.reset();
+}
 }
@@ -31,15 +31,18 @@
 #pragma once
 
 #include "mongo/db/collection_index_usage_tracker.h"
+#include "mongo/db/collection_query_shape_stats_tracker.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/query_settings.h"
 #include "mongo/db/update_index_data.h"
 
 namespace mongo {
 
+class CanonicalQuery;
 class Collection;
 class IndexDescriptor;
 class OperationContext;
+struct PlanSummaryStats;
 
 /**
  * this is for storing things that you want to cache about a single collection
@@ -105,6 +108,26 @@ public:
      */
     void notifyOfQuery(OperationContext* txn, const std::set<std::string>& indexesUsed);
 
+    /**
+     * Signal to the cache that an operation of type 'opType' has finished executing the query
+     * 'cq' in 'latencyMicros' microseconds. Statistics are aggregated by the plan cache shape of
+     * 'cq'. Does nothing if 'cq' is null or query shape statistics are disabled.
+     */
+    void notifyOfQueryShapeExecution(CollectionQueryShapeStatsTracker::OpType opType,
+                                     const CanonicalQuery* cq,
+                                     const PlanSummaryStats& summaryStats,
+                                     long long latencyMicros);
+
+    /**
+     * Returns a copy of the per-query-shape execution statistics for this collection.
+     */
+    std::vector<CollectionQueryShapeStatsTracker::ShapeStats> getQueryShapeStats() const;
+
+    /**
+     * Discards all per-query-shape execution statistics for this collection.
+     */
+    void resetQueryShapeStats();
+
 private:
     Collection* _collection;  // not owned
 
@@ -122,6 +145,9 @@ private:
     // Tracks index usage statistics for this collection.
     CollectionIndexUsageTracker _indexUsageTracker;
 
+    // Tracks execution statistics by query shape for this collection.
+    CollectionQueryShapeStatsTracker _queryShapeStatsTracker;
+
     void computeIndexKeys(OperationContext* txn);
     void updatePlanCacheIndexEntries(OperationContext* txn);
 
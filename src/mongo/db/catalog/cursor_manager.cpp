@@ -327,14 +327,18 @@ void CursorManager::invalidateAll(bool collectionGoingAway, const std::string& r
     stdx::lock_guard<SimpleMutex> lk(_mutex);
     fassert(28819, !BackgroundOperation::inProgForNs(_nss));
 
-    for (ExecSet::iterator it = _nonCachedExecutors.begin(); it != _nonCachedExecutors.end();
-         ++it) {
-        // we kill the executor, but it deletes itself
-        PlanExecutor* exec = *it;
-        exec->kill(reason);
-        invariant(exec->collection() == NULL);
+    for (auto& partition : _nonCachedExecutors) {
+        stdx::lock_guard<SimpleMutex> partitionLock(partition.mutex);
+        for (ExecSet::iterator it = partition.executors.begin();
+             it != partition.executors.end();
+             ++it) {
+            // we kill the executor, but it deletes itself
+            PlanExecutor* exec = *it;
+            exec->kill(reason);
+            invariant(exec->collection() == NULL);
+        }
+        partition.executors.clear();
     }
-    _nonCachedExecutors.clear();
 
     if (collectionGoingAway) {
         // we're going to wipe out the world
@@ -397,14 +401,18 @@ void CursorManager::invalidateDocument(OperationContext* txn,
         return;
     }
 
-    stdx::lock_guard<SimpleMutex> lk(_mutex);
-
-    for (ExecSet::iterator it = _nonCachedExecutors.begin(); it != _nonCachedExecutors.end();
-         ++it) {
-        PlanExecutor* exec = *it;
-        exec->invalidate(txn, dl, type);
+    for (auto& partition : _nonCachedExecutors) {
+        stdx::lock_guard<SimpleMutex> partitionLock(partition.mutex);
+        for (ExecSet::iterator it = partition.executors.begin();
+             it != partition.executors.end();
+             ++it) {
+            PlanExecutor* exec = *it;
+            exec->invalidate(txn, dl, type);
+        }
     }
 
+    stdx::lock_guard<SimpleMutex> lk(_mutex);
+
     for (CursorMap::const_iterator i = _cursors.begin(); i != _cursors.end(); ++i) {
         PlanExecutor* exec = i->second->getExecutor();
         if (exec) {
@@ -434,15 +442,23 @@ std::size_t CursorManager::timeoutCursors(int millisSinceLastCall) {
     return toDelete.size();
 }
 
+CursorManager::ExecutorPartition& CursorManager::_partitionFor(PlanExecutor* exec) {
+    // Executors are heap allocated, so the low bits of their addresses carry no information.
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(exec);
+    return _nonCachedExecutors[(addr >> 6) % kNumExecutorPartitions];
+}
+
 void CursorManager::registerExecutor(PlanExecutor* exec) {
-    stdx::lock_guard<SimpleMutex> lk(_mutex);
-    const std::pair<ExecSet::iterator, bool> result = _nonCachedExecutors.insert(exec);
+    ExecutorPartition& partition = _partitionFor(exec);
+    stdx::lock_guard<SimpleMutex> lk(partition.mutex);
+    const std::pair<ExecSet::iterator, bool> result = partition.executors.insert(exec);
     invariant(result.second);  // make sure this was inserted
 }
 
 void CursorManager::deregisterExecutor(PlanExecutor* exec) {
-    stdx::lock_guard<SimpleMutex> lk(_mutex);
-    _nonCachedExecutors.erase(exec);
+    ExecutorPartition& partition = _partitionFor(exec);
+    stdx::lock_guard<SimpleMutex> lk(partition.mutex);
+    partition.executors.erase(exec);
 }
 
 ClientCursor* CursorManager::find(CursorId id, bool pin) {
@@ -150,10 +150,28 @@ private:
     unsigned _collectionCacheRuntimeId;
     std::unique_ptr<PseudoRandom> _random;
 
+    typedef unordered_set<PlanExecutor*> ExecSet;
+
+    /**
+     * A slice of the registry of executors which are not owned by a ClientCursor.
+     */
+    struct ExecutorPartition {
+        SimpleMutex mutex;
+        ExecSet executors;
+    };
+
+    // Every find, getMore and aggregation registers an executor for as long as it runs, so the
+    // registry is split into partitions, each with its own mutex, to keep concurrent readers of
+    // one collection from serializing on '_mutex'.
+    static const size_t kNumExecutorPartitions = 16;
+
+    ExecutorPartition& _partitionFor(PlanExecutor* exec);
+
+    // Protects '_cursors'. A partition's mutex may be acquired while holding '_mutex', but not
+    // the other way around.
     mutable SimpleMutex _mutex;
 
-    typedef unordered_set<PlanExecutor*> ExecSet;
-    ExecSet _nonCachedExecutors;
+    ExecutorPartition _nonCachedExecutors[kNumExecutorPartitions];
 
     typedef std::map<CursorId, ClientCursor*> CursorMap;
     CursorMap _cursors;
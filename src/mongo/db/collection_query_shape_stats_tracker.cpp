@@ -0,0 +1,162 @@
+/**
+ * Copyright (C) 2016 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/collection_query_shape_stats_tracker.h"
+
+#include <algorithm>
+
+#include "mongo/platform/bits.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/clock_source.h"
+
+namespace mongo {
+
+const int CollectionQueryShapeStatsTracker::kFirstLatencyBucketBits;
+const size_t CollectionQueryShapeStatsTracker::kNumLatencyBuckets;
+const size_t CollectionQueryShapeStatsTracker::kNumPartitions;
+const size_t CollectionQueryShapeStatsTracker::kNumOpTypes;
+
+CollectionQueryShapeStatsTracker::CollectionQueryShapeStatsTracker(ClockSource* clockSource,
+                                                                   size_t maxShapes)
+    : _clockSource(clockSource), _maxShapes(maxShapes) {
+    invariant(_clockSource);
+}
+
+void CollectionQueryShapeStatsTracker::recordExecution(
+    OpType opType,
+    StringData shapeKey,
+    const stdx::function<BSONObj()>& makeShape,
+    const ExecutionStats& stats) {
+    Partition& partition = _partitions[StringData::Hasher()(shapeKey) % kNumPartitions];
+    StringMap<ShapeStats>& shapes = partition.shapes[static_cast<size_t>(opType)];
+
+    const StringMap<ShapeStats>::HashedKey hashedKey(shapeKey);
+
+    stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+
+    const bool isNewShape = shapes.find(hashedKey) == shapes.end();
+
+    if (isNewShape) {
+        if (_numShapes.fetchAndAdd(1) >= _maxShapes) {
+            _numShapes.fetchAndSubtract(1);
+            partition.droppedExecutions++;
+            return;
+        }
+
+        ShapeStats newShape;
+        newShape.opType = opType;
+        newShape.shape = makeShape().getOwned();
+        newShape.firstSeen = _clockSource->now();
+        shapes[hashedKey] = std::move(newShape);
+        partition.numShapes++;
+    }
+
+    ShapeStats& shapeStats = shapes[hashedKey];
+
+    shapeStats.execCount++;
+    shapeStats.totalLatencyMicros += stats.latencyMicros;
+    shapeStats.maxLatencyMicros = std::max(shapeStats.maxLatencyMicros, stats.latencyMicros);
+    shapeStats.latencyHistogram[latencyBucket(stats.latencyMicros)]++;
+    shapeStats.keysExamined += stats.keysExamined;
+    shapeStats.docsExamined += stats.docsExamined;
+    shapeStats.nReturned += stats.nReturned;
+    if (stats.fromPlanCache) {
+        shapeStats.planCacheHits++;
+    }
+}
+
+std::vector<CollectionQueryShapeStatsTracker::ShapeStats>
+CollectionQueryShapeStatsTracker::getStats() const {
+    std::vector<ShapeStats> out;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+        for (auto&& shapes : partition.shapes) {
+            for (auto&& entry : shapes) {
+                out.push_back(entry.second);
+            }
+        }
+    }
+    return out;
+}
+
+long long CollectionQueryShapeStatsTracker::getNumDroppedExecutions() const {
+    long long dropped = 0;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+        dropped += partition.droppedExecutions;
+    }
+    return dropped;
+}
+
+void CollectionQueryShapeStatsTracker::reset() {
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+        for (auto&& shapes : partition.shapes) {
+            shapes = StringMap<ShapeStats>();
+        }
+        _numShapes.fetchAndSubtract(partition.numShapes);
+        partition.numShapes = 0;
+        partition.droppedExecutions = 0;
+    }
+}
+
+// static
+size_t CollectionQueryShapeStatsTracker::latencyBucket(long long latencyMicros) {
+    if (latencyMicros < (1LL << kFirstLatencyBucketBits)) {
+        return 0;
+    }
+
+    // Number of bits needed to represent 'latencyMicros'.
+    const int bits = 64 - countLeadingZeros64(latencyMicros);
+    return std::min(size_t(bits - kFirstLatencyBucketBits), kNumLatencyBuckets - 1);
+}
+
+// static
+long long CollectionQueryShapeStatsTracker::latencyBucketLowerBound(size_t bucket) {
+    invariant(bucket < kNumLatencyBuckets);
+    return bucket == 0 ? 0 : 1LL << (bucket + kFirstLatencyBucketBits - 1);
+}
+
+// static
+StringData CollectionQueryShapeStatsTracker::opTypeToString(OpType opType) {
+    switch (opType) {
+        case OpType::kFind:
+            return "find";
+        case OpType::kUpdate:
+            return "update";
+        case OpType::kDelete:
+            return "delete";
+        case OpType::kGetMore:
+            return "getMore";
+    }
+    MONGO_UNREACHABLE;
+}
+
+}  // namespace mongo
@@ -0,0 +1,172 @@
+/**
+ * Copyright (C) 2016 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/functional.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class ClockSource;
+
+/**
+ * CollectionQueryShapeStatsTracker aggregates execution statistics for a collection by query
+ * shape, as computed by the PlanCache, and by the kind of operation that ran the query.
+ *
+ * The number of shapes tracked is bounded; executions of shapes that do not fit are counted but
+ * otherwise dropped. Recording is safe to call concurrently from multiple threads. To keep
+ * contention low, shapes are spread across several independently locked partitions, which share
+ * one count of the shapes tracked.
+ */
+class CollectionQueryShapeStatsTracker {
+    MONGO_DISALLOW_COPYING(CollectionQueryShapeStatsTracker);
+
+public:
+    // Each getMore batch of a find is recorded as a separate kGetMore execution of the find's
+    // shape, so kFind executions only account for the initial batch.
+    enum class OpType { kFind, kUpdate, kDelete, kGetMore };
+
+    // Latencies are bucketed by powers of two. Bucket 0 holds latencies below
+    // 2^kFirstLatencyBucketBits microseconds, and the last bucket is open-ended.
+    static const int kFirstLatencyBucketBits = 7;
+    static const size_t kNumLatencyBuckets = 20;
+
+    /**
+     * The statistics of a single execution of a query.
+     */
+    struct ExecutionStats {
+        long long latencyMicros = 0;
+        long long keysExamined = 0;
+        long long docsExamined = 0;
+        long long nReturned = 0;
+        bool fromPlanCache = false;
+    };
+
+    /**
+     * The statistics accumulated for one query shape.
+     */
+    struct ShapeStats {
+        OpType opType = OpType::kFind;
+
+        // The query, sort and projection of the first operation seen with this shape.
+        BSONObj shape;
+
+        // Date/Time that we started tracking this shape.
+        Date_t firstSeen;
+
+        long long execCount = 0;
+        long long totalLatencyMicros = 0;
+        long long maxLatencyMicros = 0;
+        std::array<long long, kNumLatencyBuckets> latencyHistogram{};
+        long long keysExamined = 0;
+        long long docsExamined = 0;
+        long long nReturned = 0;
+        long long planCacheHits = 0;
+    };
+
+    /**
+     * Constructs a CollectionQueryShapeStatsTracker which tracks at most 'maxShapes' shapes.
+     *
+     * Does not take ownership of 'clockSource'. 'clockSource' must refer to a non-null clock
+     * source that is valid for the lifetime of the constructed CollectionQueryShapeStatsTracker.
+     */
+    CollectionQueryShapeStatsTracker(ClockSource* clockSource, size_t maxShapes);
+
+    /**
+     * Adds 'stats' to the statistics for the shape identified by 'shapeKey' and 'opType'.
+     * 'makeShape' is called to produce the displayed shape only when a shape is seen for the first
+     * time.
+     */
+    void recordExecution(OpType opType,
+                         StringData shapeKey,
+                         const stdx::function<BSONObj()>& makeShape,
+                         const ExecutionStats& stats);
+
+    /**
+     * Returns a copy of the statistics for every tracked shape.
+     */
+    std::vector<ShapeStats> getStats() const;
+
+    /**
+     * Returns the number of executions that were not recorded because the table was full.
+     */
+    long long getNumDroppedExecutions() const;
+
+    /**
+     * Forgets all shapes and their statistics.
+     */
+    void reset();
+
+    /**
+     * Returns the index of the latency histogram bucket which counts 'latencyMicros'.
+     */
+    static size_t latencyBucket(long long latencyMicros);
+
+    /**
+     * Returns the smallest latency, in microseconds, counted by histogram bucket 'bucket'.
+     */
+    static long long latencyBucketLowerBound(size_t bucket);
+
+    static StringData opTypeToString(OpType opType);
+
+private:
+    static const size_t kNumPartitions = 16;
+    static const size_t kNumOpTypes = 4;
+
+    struct Partition {
+        mutable stdx::mutex mutex;
+
+        // Map from shape key to statistics, one map per OpType.
+        std::array<StringMap<ShapeStats>, kNumOpTypes> shapes;
+        size_t numShapes = 0;
+        long long droppedExecutions = 0;
+    };
+
+    ClockSource* const _clockSource;
+
+    // The maximum number of shapes tracked across all partitions.
+    const unsigned long long _maxShapes;
+
+    // The number of shapes tracked across all partitions. A partition reserves room for a new
+    // shape here before inserting it.
+    AtomicUInt64 _numShapes;
+
+    std::array<Partition, kNumPartitions> _partitions;
+};
+
+}  // namespace mongo
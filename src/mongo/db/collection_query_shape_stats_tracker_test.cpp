@@ -0,0 +1,178 @@
+/**
+ * Copyright (C) 2016 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/collection_query_shape_stats_tracker.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/clock_source_mock.h"
+
+namespace mongo {
+namespace {
+
+using OpType = CollectionQueryShapeStatsTracker::OpType;
+
+const size_t kMaxShapes = 64;
+
+class CollectionQueryShapeStatsTrackerTest : public unittest::Test {
+protected:
+    CollectionQueryShapeStatsTrackerTest() : _tracker(&_clockSource, kMaxShapes) {}
+
+    /**
+     * Returns an unowned pointer to the tracker owned by this test fixture.
+     */
+    CollectionQueryShapeStatsTracker* getTracker() {
+        return &_tracker;
+    }
+
+    /**
+     * Records an execution of 'shapeKey' with the given latency and otherwise empty stats.
+     */
+    void record(OpType opType, StringData shapeKey, long long latencyMicros) {
+        CollectionQueryShapeStatsTracker::ExecutionStats stats;
+        stats.latencyMicros = latencyMicros;
+        getTracker()->recordExecution(
+            opType, shapeKey, [&] { return BSON("key" << shapeKey); }, stats);
+    }
+
+private:
+    ClockSourceMock _clockSource;
+    CollectionQueryShapeStatsTracker _tracker;
+};
+
+// Test that a newly constructed tracker has no shapes.
+TEST_F(CollectionQueryShapeStatsTrackerTest, Empty) {
+    ASSERT(getTracker()->getStats().empty());
+    ASSERT_EQUALS(0, getTracker()->getNumDroppedExecutions());
+}
+
+// Test that executions of the same shape are aggregated.
+TEST_F(CollectionQueryShapeStatsTrackerTest, AggregatesExecutionsOfSameShape) {
+    CollectionQueryShapeStatsTracker::ExecutionStats stats;
+    stats.latencyMicros = 100;
+    stats.keysExamined = 10;
+    stats.docsExamined = 5;
+    stats.nReturned = 2;
+    stats.fromPlanCache = true;
+
+    int shapesMade = 0;
+    auto makeShape = [&] {
+        shapesMade++;
+        return BSON("query" << BSON("a" << 1));
+    };
+    getTracker()->recordExecution(OpType::kFind, "shape", makeShape, stats);
+    stats.latencyMicros = 300;
+    stats.fromPlanCache = false;
+    getTracker()->recordExecution(OpType::kFind, "shape", makeShape, stats);
+
+    // The displayed shape is only built the first time the shape is seen.
+    ASSERT_EQUALS(1, shapesMade);
+
+    auto allStats = getTracker()->getStats();
+    ASSERT_EQUALS(1U, allStats.size());
+    const auto& shapeStats = allStats[0];
+    ASSERT(OpType::kFind == shapeStats.opType);
+    ASSERT_EQUALS(BSON("query" << BSON("a" << 1)), shapeStats.shape);
+    ASSERT_EQUALS(2, shapeStats.execCount);
+    ASSERT_EQUALS(400, shapeStats.totalLatencyMicros);
+    ASSERT_EQUALS(300, shapeStats.maxLatencyMicros);
+    ASSERT_EQUALS(20, shapeStats.keysExamined);
+    ASSERT_EQUALS(10, shapeStats.docsExamined);
+    ASSERT_EQUALS(4, shapeStats.nReturned);
+    ASSERT_EQUALS(1, shapeStats.planCacheHits);
+}
+
+// Test that the same shape key is tracked separately for each type of operation.
+TEST_F(CollectionQueryShapeStatsTrackerTest, SeparatesOpTypes) {
+    record(OpType::kFind, "shape", 1);
+    record(OpType::kUpdate, "shape", 1);
+    record(OpType::kDelete, "shape", 1);
+    record(OpType::kGetMore, "shape", 1);
+    ASSERT_EQUALS(4U, getTracker()->getStats().size());
+}
+
+// Test that shapes beyond the size limit are dropped and counted.
+TEST_F(CollectionQueryShapeStatsTrackerTest, BoundsNumberOfShapes) {
+    const int numShapes = 10 * kMaxShapes;
+    for (int i = 0; i < numShapes; i++) {
+        record(OpType::kFind, std::to_string(i), 1);
+    }
+
+    const auto allStats = getTracker()->getStats();
+    ASSERT_EQUALS(kMaxShapes, allStats.size());
+    ASSERT_EQUALS(numShapes,
+                  static_cast<long long>(allStats.size()) +
+                      getTracker()->getNumDroppedExecutions());
+}
+
+// Test that the size limit holds across partitions, even for limits below the number of
+// partitions, and that reset frees room for new shapes.
+TEST(CollectionQueryShapeStatsTrackerLimit, SingleShape) {
+    ClockSourceMock clockSource;
+    CollectionQueryShapeStatsTracker tracker(&clockSource, 1);
+    CollectionQueryShapeStatsTracker::ExecutionStats stats;
+    auto makeShape = [] { return BSONObj(); };
+
+    for (int i = 0; i < 32; i++) {
+        tracker.recordExecution(OpType::kFind, std::to_string(i), makeShape, stats);
+    }
+    ASSERT_EQUALS(1U, tracker.getStats().size());
+    ASSERT_EQUALS(31, tracker.getNumDroppedExecutions());
+
+    tracker.reset();
+    tracker.recordExecution(OpType::kFind, "31", makeShape, stats);
+    ASSERT_EQUALS(1U, tracker.getStats().size());
+    ASSERT_EQUALS(0, tracker.getNumDroppedExecutions());
+}
+
+// Test that reset forgets all shapes.
+TEST_F(CollectionQueryShapeStatsTrackerTest, Reset) {
+    record(OpType::kFind, "shape", 1);
+    getTracker()->reset();
+    ASSERT(getTracker()->getStats().empty());
+}
+
+// Test the boundaries of the latency histogram buckets.
+TEST(CollectionQueryShapeStatsTrackerLatency, Buckets) {
+    using Tracker = CollectionQueryShapeStatsTracker;
+    ASSERT_EQUALS(0U, Tracker::latencyBucket(0));
+    ASSERT_EQUALS(0U, Tracker::latencyBucket(127));
+    ASSERT_EQUALS(1U, Tracker::latencyBucket(128));
+    ASSERT_EQUALS(1U, Tracker::latencyBucket(255));
+    ASSERT_EQUALS(2U, Tracker::latencyBucket(256));
+    ASSERT_EQUALS(Tracker::kNumLatencyBuckets - 1,
+                  Tracker::latencyBucket(std::numeric_limits<long long>::max()));
+
+    for (size_t bucket = 0; bucket < Tracker::kNumLatencyBuckets; bucket++) {
+        ASSERT_EQUALS(bucket, Tracker::latencyBucket(Tracker::latencyBucketLowerBound(bucket)));
+    }
+}
+
+}  // namespace
+}  // namespace mongo
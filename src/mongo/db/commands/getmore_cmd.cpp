@@ -299,6 +299,9 @@ public:
         exec->reattachToOperationContext(txn);
         exec->restoreState();
 
+        PlanSummaryStats preBatchStats;
+        Explain::getSummaryStats(*exec, &preBatchStats);
+
         uint64_t notifierVersion = 0;
         std::shared_ptr<CappedInsertNotifier> notifier;
         if (isCursorAwaitData(cursor)) {
@@ -363,6 +366,11 @@ public:
             }
         }
 
+        // Agg cursors do not hold the collection lock here, and are not recorded.
+        if (ctx) {
+            endGetMoreBatch(txn, ctx->getCollection(), *exec, preBatchStats);
+        }
+
         if (shouldSaveCursorGetMore(state, exec, isCursorTailable(cursor))) {
             respondWithId = request.cursorid;
 
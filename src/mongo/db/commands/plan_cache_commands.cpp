@@ -103,6 +103,7 @@ MONGO_INITIALIZER_WITH_PREREQUISITES(SetupPlanCacheCommands,
     // the ActionType construction will be completed first.
     new PlanCacheListQueryShapes();
     new PlanCacheClear();
+    new PlanCacheResetQueryShapeStats();
     new PlanCacheListPlans();
 
     return Status::OK();
@@ -342,6 +343,31 @@ Status PlanCacheClear::clear(OperationContext* txn,
     return Status::OK();
 }
 
+PlanCacheResetQueryShapeStats::PlanCacheResetQueryShapeStats()
+    : PlanCacheCommand("planCacheResetQueryShapeStats",
+                       "Discards the execution statistics gathered for each query shape in a "
+                       "collection.",
+                       ActionType::planCacheWrite) {}
+
+Status PlanCacheResetQueryShapeStats::runPlanCacheCommand(OperationContext* txn,
+                                                          const std::string& ns,
+                                                          BSONObj& cmdObj,
+                                                          BSONObjBuilder* bob) {
+    // This is a read lock. The query shape statistics are owned by the collection.
+    AutoGetCollectionForRead ctx(txn, ns);
+
+    Collection* collection = ctx.getCollection();
+    if (!collection) {
+        // No collection - nothing to do. Return OK status.
+        return Status::OK();
+    }
+
+    collection->infoCache()->resetQueryShapeStats();
+    LOG(1) << ns << ": reset query shape statistics";
+
+    return Status::OK();
+}
+
 PlanCacheListPlans::PlanCacheListPlans()
     : PlanCacheCommand("planCacheListPlans",
                        "Displays the cached plans for a query shape.",
@@ -153,6 +153,21 @@ public:
                         const BSONObj& cmdObj);
 };
 
+/**
+ * planCacheResetQueryShapeStats
+ *
+ * { planCacheResetQueryShapeStats: <collection> }
+ *
+ */
+class PlanCacheResetQueryShapeStats : public PlanCacheCommand {
+public:
+    PlanCacheResetQueryShapeStats();
+    virtual Status runPlanCacheCommand(OperationContext* txn,
+                                       const std::string& ns,
+                                       BSONObj& cmdObj,
+                                       BSONObjBuilder* bob);
+};
+
 /**
  * planCacheListPlans
  *
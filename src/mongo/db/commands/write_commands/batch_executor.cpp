@@ -1242,6 +1242,11 @@ static void multiUpdate(OperationContext* txn,
             PlanSummaryStats summary;
             Explain::getSummaryStats(*exec, &summary);
             collection->infoCache()->notifyOfQuery(txn, summary.indexesUsed);
+            collection->infoCache()->notifyOfQueryShapeExecution(
+                CollectionQueryShapeStatsTracker::OpType::kUpdate,
+                exec->getCanonicalQuery(),
+                summary,
+                CurOp::get(txn)->elapsedMicros());
 
             const UpdateStats* updateStats = UpdateStage::getUpdateStats(exec.get());
             UpdateStage::fillOutOpDebug(updateStats, &summary, debug);
@@ -1366,6 +1371,11 @@ static void multiRemove(OperationContext* txn,
             PlanSummaryStats summary;
             Explain::getSummaryStats(*exec, &summary);
             collection->infoCache()->notifyOfQuery(txn, summary.indexesUsed);
+            collection->infoCache()->notifyOfQueryShapeExecution(
+                CollectionQueryShapeStatsTracker::OpType::kDelete,
+                exec->getCanonicalQuery(),
+                summary,
+                CurOp::get(txn)->elapsedMicros());
             CurOp::get(txn)->debug().fromMultiPlanner = summary.fromMultiPlanner;
             CurOp::get(txn)->debug().replanned = summary.replanned;
 
@@ -57,6 +57,7 @@
 #include "mongo/db/range_arithmetic.h"
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/repl/replication_coordinator_global.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/storage/data_protector.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
@@ -81,6 +82,15 @@ using std::stringstream;
 
 using logger::LogComponent;
 
+Helpers::RemoveRangeProgress Helpers::removeRangeProgress;
+
+// Maximum number of documents removeRange deletes under a single write lock acquisition before
+// waiting for replication.
+MONGO_EXPORT_SERVER_PARAMETER(rangeDeleterBatchSize, int, 128);
+
+// Time removeRange sleeps between two batches, to let replication and the storage engine catch up.
+MONGO_EXPORT_SERVER_PARAMETER(rangeDeleterBatchDelayMS, int, 20);
+
 void Helpers::ensureIndex(OperationContext* txn,
                           Collection* collection,
                           BSONObj keyPattern,
@@ -352,7 +362,15 @@ long long Helpers::removeRange(OperationContext* txn,
 
     Milliseconds millisWaitingForReplication{0};
 
-    while (1) {
+    removeRangeProgress.activeRemovals.fetchAndAdd(1);
+    ON_BLOCK_EXIT([] { removeRangeProgress.activeRemovals.fetchAndSubtract(1); });
+
+    const int batchSize = std::max(1, rangeDeleterBatchSize.load());
+
+    bool done = false;
+    while (!done) {
+        long long numDeletedInBatch = 0;
+
         // Scoping for write lock.
         {
             OldClientWriteContext ctx(txn, ns);
@@ -375,80 +393,102 @@ long long Helpers::removeRange(OperationContext* txn,
                                            InternalPlanner::IXSCAN_FETCH));
             exec->setYieldPolicy(PlanExecutor::YIELD_AUTO);
 
-            RecordId rloc;
-            BSONObj obj;
-            PlanExecutor::ExecState state;
-            // This may yield so we cannot touch nsd after this.
-            state = exec->getNext(&obj, &rloc);
-            if (PlanExecutor::IS_EOF == state) {
-                break;
-            }
-
-            if (PlanExecutor::FAILURE == state || PlanExecutor::DEAD == state) {
-                warning(LogComponent::kSharding)
-                    << PlanExecutor::statestr(state) << " - cursor error while trying to delete "
-                    << min << " to " << max << " in " << ns << ": "
-                    << WorkingSetCommon::toStatusString(obj)
-                    << ", stats: " << Explain::getWinningPlanStats(exec.get()) << endl;
-                break;
-            }
+            // Delete up to a batch worth of documents under this lock acquisition, reusing the
+            // same index scan instead of restarting it for every document.
+            while (numDeletedInBatch < batchSize) {
+                RecordId rloc;
+                BSONObj obj;
+                PlanExecutor::ExecState state;
+                // This may yield so we cannot touch nsd after this.
+                state = exec->getNext(&obj, &rloc);
+                if (PlanExecutor::IS_EOF == state) {
+                    done = true;
+                    break;
+                }
 
-            verify(PlanExecutor::ADVANCED == state);
+                if (PlanExecutor::FAILURE == state || PlanExecutor::DEAD == state) {
+                    warning(LogComponent::kSharding)
+                        << PlanExecutor::statestr(state)
+                        << " - cursor error while trying to delete " << min << " to " << max
+                        << " in " << ns << ": " << WorkingSetCommon::toStatusString(obj)
+                        << ", stats: " << Explain::getWinningPlanStats(exec.get()) << endl;
+                    done = true;
+                    break;
+                }
 
-            WriteUnitOfWork wuow(txn);
+                verify(PlanExecutor::ADVANCED == state);
+
+                WriteUnitOfWork wuow(txn);
+
+                if (onlyRemoveOrphanedDocs) {
+                    // Do a final check in the write lock to make absolutely sure that our
+                    // collection hasn't been modified in a way that invalidates our migration
+                    // cleanup.
+
+                    // We should never be able to turn off the sharding state once enabled, but
+                    // in the future we might want to.
+                    verify(ShardingState::get(txn)->enabled());
+
+                    bool docIsOrphan;
+
+                    // In write lock, so will be the most up-to-date version
+                    std::shared_ptr<CollectionMetadata> metadataNow =
+                        ShardingState::get(txn)->getCollectionMetadata(ns);
+                    if (metadataNow) {
+                        ShardKeyPattern kp(metadataNow->getKeyPattern());
+                        BSONObj key = kp.extractShardKeyFromDoc(obj);
+                        docIsOrphan =
+                            !metadataNow->keyBelongsToMe(key) && !metadataNow->keyIsPending(key);
+                    } else {
+                        docIsOrphan = false;
+                    }
+
+                    if (!docIsOrphan) {
+                        warning(LogComponent::kSharding)
+                            << "aborting migration cleanup for chunk " << min << " to " << max
+                            << (metadataNow ? (string) " at document " + obj.toString() : "")
+                            << ", collection " << ns << " has changed " << endl;
+                        done = true;
+                        break;
+                    }
+                }
 
-            if (onlyRemoveOrphanedDocs) {
-                // Do a final check in the write lock to make absolutely sure that our
-                // collection hasn't been modified in a way that invalidates our migration
-                // cleanup.
+                NamespaceString nss(ns);
+                if (!repl::getGlobalReplicationCoordinator()->canAcceptWritesFor(nss)) {
+                    warning() << "stepped down from primary while deleting chunk; "
+                              << "orphaning data in " << ns << " in range [" << min << ", " << max
+                              << ")";
+                    return numDeleted;
+                }
 
-                // We should never be able to turn off the sharding state once enabled, but
-                // in the future we might want to.
-                verify(ShardingState::get(txn)->enabled());
+                if (callback)
+                    callback->goingToDelete(obj);
 
-                bool docIsOrphan;
+                // The scan is positioned on the document being deleted, so detach it first.
+                exec->saveState();
+                collection->deleteDocument(txn, rloc, fromMigrate);
+                wuow.commit();
 
-                // In write lock, so will be the most up-to-date version
-                std::shared_ptr<CollectionMetadata> metadataNow =
-                    ShardingState::get(txn)->getCollectionMetadata(ns);
-                if (metadataNow) {
-                    ShardKeyPattern kp(metadataNow->getKeyPattern());
-                    BSONObj key = kp.extractShardKeyFromDoc(obj);
-                    docIsOrphan =
-                        !metadataNow->keyBelongsToMe(key) && !metadataNow->keyIsPending(key);
-                } else {
-                    docIsOrphan = false;
-                }
+                numDeleted++;
+                numDeletedInBatch++;
+                removeRangeProgress.deletedDocs.fetchAndAdd(1);
 
-                if (!docIsOrphan) {
-                    warning(LogComponent::kSharding)
-                        << "aborting migration cleanup for chunk " << min << " to " << max
-                        << (metadataNow ? (string) " at document " + obj.toString() : "")
-                        << ", collection " << ns << " has changed " << endl;
+                if (!exec->restoreState()) {
                     break;
                 }
             }
+        }
 
-            NamespaceString nss(ns);
-            if (!repl::getGlobalReplicationCoordinator()->canAcceptWritesFor(nss)) {
-                warning() << "stepped down from primary while deleting chunk; "
-                          << "orphaning data in " << ns << " in range [" << min << ", " << max
-                          << ")";
-                return numDeleted;
-            }
-
-            if (callback)
-                callback->goingToDelete(obj);
-
-            collection->deleteDocument(txn, rloc, fromMigrate);
-            wuow.commit();
-            numDeleted++;
+        if (numDeletedInBatch == 0) {
+            break;
         }
 
+        removeRangeProgress.batches.fetchAndAdd(1);
+
         // TODO remove once the yielding below that references this timer has been removed
         Timer secondaryThrottleTime;
 
-        if (writeConcern.shouldWaitForOtherNodes() && numDeleted > 0) {
+        if (writeConcern.shouldWaitForOtherNodes()) {
             repl::ReplicationCoordinator::StatusAndDuration replStatus =
                 repl::getGlobalReplicationCoordinator()->awaitReplication(
                     txn,
@@ -461,6 +501,15 @@ long long Helpers::removeRange(OperationContext* txn,
                 massertStatusOK(replStatus.status);
             }
             millisWaitingForReplication += replStatus.duration;
+            removeRangeProgress.waitForReplMillis.fetchAndAdd(
+                durationCount<Milliseconds>(replStatus.duration));
+        }
+
+        // Give replication and the storage engine a chance to catch up between batches.
+        const int batchDelayMS = rangeDeleterBatchDelayMS.load();
+        if (!done && batchDelayMS > 0) {
+            sleepmillis(batchDelayMS);
+            removeRangeProgress.throttledMillis.fetchAndAdd(batchDelayMS);
         }
     }
 
@@ -34,6 +34,7 @@
 #include "mongo/db/db.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/data_protector.h"
+#include "mongo/platform/atomic_word.h"
 
 namespace mongo {
 
@@ -44,6 +45,12 @@ class OperationContext;
 struct KeyRange;
 struct WriteConcernOptions;
 
+// Maximum number of documents Helpers::removeRange deletes per write lock acquisition.
+extern std::atomic<int> rangeDeleterBatchSize;  // NOLINT
+
+// Milliseconds Helpers::removeRange sleeps between two batches.
+extern std::atomic<int> rangeDeleterBatchDelayMS;  // NOLINT
+
 /**
  * db helpers are helper functions and classes that let us easily manipulate the local
  * database instance in-proc.
@@ -166,6 +173,9 @@ struct Helpers {
      *
      * Returns -1 when no usable index exists
      *
+     * Documents are deleted in batches of "rangeDeleterBatchSize" per lock acquisition, waiting
+     * for 'secondaryThrottle' and sleeping "rangeDeleterBatchDelayMS" between batches.
+     *
      * Does oplog the individual document deletions.
      * // TODO: Refactor this mechanism, it is growing too large
      */
@@ -177,6 +187,20 @@ struct Helpers {
                                  bool fromMigrate = false,
                                  bool onlyRemoveOrphanedDocs = false);
 
+    /**
+     * Cumulative progress of removeRange calls since startup. Reported by the "rangeDeleter"
+     * server status section.
+     */
+    struct RemoveRangeProgress {
+        AtomicInt64 activeRemovals;
+        AtomicInt64 batches;
+        AtomicInt64 deletedDocs;
+        AtomicInt64 waitForReplMillis;
+        AtomicInt64 throttledMillis;
+    };
+
+    static RemoveRangeProgress removeRangeProgress;
+
     /**
      * Remove all documents from a collection.
      * You do not need to set the database before calling.
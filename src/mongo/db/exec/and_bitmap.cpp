@@ -0,0 +1,261 @@
+/**
+ * Copyright (C) 2016 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/and_bitmap.h"
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/exec/working_set.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace {
+
+// Upper limit for buffered data.
+// Stage execution will fail once the bitmaps use more memory than this threshold.
+const size_t kDefaultMaxMemUsageBytes = 32 * 1024 * 1024;
+
+}  // namespace
+
+namespace mongo {
+
+using std::unique_ptr;
+using stdx::make_unique;
+
+// static
+const char* AndBitmapStage::kStageType = "AND_BITMAP";
+
+AndBitmapStage::AndBitmapStage(OperationContext* opCtx,
+                               WorkingSet* ws,
+                               const Collection* collection)
+    : AndBitmapStage(opCtx, ws, collection, kDefaultMaxMemUsageBytes) {}
+
+AndBitmapStage::AndBitmapStage(OperationContext* opCtx,
+                               WorkingSet* ws,
+                               const Collection* collection,
+                               size_t maxMemUsage)
+    : PlanStage(kStageType, opCtx),
+      _collection(collection),
+      _ws(ws),
+      _readingChildren(true),
+      _currentChild(0),
+      _maxMemUsage(maxMemUsage) {}
+
+AndBitmapStage::~AndBitmapStage() {}
+
+void AndBitmapStage::addChild(PlanStage* child) {
+    _children.emplace_back(child);
+}
+
+size_t AndBitmapStage::getMemUsage() const {
+    return _intersection.getMemUsage() + _probe.getMemUsage();
+}
+
+bool AndBitmapStage::isEOF() {
+    if (_readingChildren) {
+        return false;
+    }
+
+    // We're done once there is nothing left in the intersection to fetch.
+    RecordId next;
+    return !_intersection.lowerBound(_nextRecordId, &next);
+}
+
+PlanStage::StageState AndBitmapStage::doWork(WorkingSetID* out) {
+    if (isEOF()) {
+        return PlanStage::IS_EOF;
+    }
+
+    if (_readingChildren) {
+        return readChild(out);
+    }
+
+    return fetchNext(out);
+}
+
+PlanStage::StageState AndBitmapStage::readChild(WorkingSetID* out) {
+    invariant(_currentChild < _children.size());
+
+    WorkingSetID id = WorkingSet::INVALID_ID;
+    StageState childStatus = _children[_currentChild]->work(&id);
+
+    if (PlanStage::ADVANCED == childStatus) {
+        WorkingSetMember* member = _ws->get(id);
+
+        // Maybe the child had an invalidation.  We intersect RecordId(s) so we can't do anything
+        // with this WSM.
+        if (!member->hasRecordId()) {
+            _ws->flagForReview(id);
+            return PlanStage::NEED_TIME;
+        }
+
+        // Only the RecordId is kept, so the member can be released right away.
+        if (0 == _currentChild) {
+            _intersection.add(member->recordId);
+        } else if (_intersection.contains(member->recordId)) {
+            _probe.add(member->recordId);
+        }
+        _ws->free(id);
+
+        if (getMemUsage() > _maxMemUsage) {
+            mongoutils::str::stream ss;
+            ss << "bitmap AND stage buffered data usage of " << getMemUsage()
+               << " bytes exceeds internal limit of " << _maxMemUsage << " bytes";
+            Status status(ErrorCodes::Overflow, ss);
+            *out = WorkingSetCommon::allocateStatusMember(_ws, status);
+            return PlanStage::FAILURE;
+        }
+
+        return PlanStage::NEED_TIME;
+    } else if (PlanStage::IS_EOF == childStatus) {
+        // Finished with a child. '_probe' holds exactly the ids common to every child so far.
+        if (_currentChild > 0) {
+            _intersection.swap(_probe);
+            _probe.clear();
+        }
+        ++_currentChild;
+
+        _specificStats.intersectionAfterChild.push_back(_intersection.size());
+
+        // If we have nothing to AND with after finishing any child, or we've finished reading
+        // every child, start fetching. An empty intersection makes us EOF.
+        if (_intersection.empty() || _currentChild == _children.size()) {
+            _readingChildren = false;
+            _nextRecordId = RecordId::min();
+        }
+
+        return PlanStage::NEED_TIME;
+    } else if (PlanStage::FAILURE == childStatus || PlanStage::DEAD == childStatus) {
+        *out = id;
+        // If a stage fails, it may create a status WSM to indicate why it
+        // failed, in which case 'id' is valid.  If ID is invalid, we
+        // create our own error message.
+        if (WorkingSet::INVALID_ID == id) {
+            mongoutils::str::stream ss;
+            ss << "bitmap AND stage failed to read in results from child " << _currentChild;
+            Status status(ErrorCodes::InternalError, ss);
+            *out = WorkingSetCommon::allocateStatusMember(_ws, status);
+        }
+        return childStatus;
+    } else {
+        if (PlanStage::NEED_YIELD == childStatus) {
+            *out = id;
+        }
+
+        return childStatus;
+    }
+}
+
+PlanStage::StageState AndBitmapStage::fetchNext(WorkingSetID* out) {
+    RecordId recordId;
+    if (!_intersection.lowerBound(_nextRecordId, &recordId)) {
+        return PlanStage::IS_EOF;
+    }
+
+    WorkingSetID id = _ws->allocate();
+    WorkingSetMember* member = _ws->get(id);
+    member->recordId = recordId;
+    _ws->transitionToRecordIdAndIdx(id);
+
+    try {
+        if (!_cursor)
+            _cursor = _collection->getCursor(getOpCtx());
+
+        if (!WorkingSetCommon::fetch(getOpCtx(), _ws, id, _cursor)) {
+            // The document was deleted since its RecordId was read from the index.
+            _ws->free(id);
+            _nextRecordId = RecordId(recordId.repr() + 1);
+            return PlanStage::NEED_TIME;
+        }
+    } catch (const WriteConflictException& wce) {
+        // Leave '_nextRecordId' alone so that this RecordId is fetched again after the yield.
+        _ws->free(id);
+        *out = WorkingSet::INVALID_ID;
+        return PlanStage::NEED_YIELD;
+    }
+
+    ++_specificStats.docsFetched;
+    _nextRecordId = RecordId(recordId.repr() + 1);
+    *out = id;
+    return PlanStage::ADVANCED;
+}
+
+void AndBitmapStage::doSaveState() {
+    if (_cursor)
+        _cursor->saveUnpositioned();
+}
+
+void AndBitmapStage::doRestoreState() {
+    if (_cursor)
+        _cursor->restore();
+}
+
+void AndBitmapStage::doDetachFromOperationContext() {
+    if (_cursor)
+        _cursor->detachFromOperationContext();
+}
+
+void AndBitmapStage::doReattachToOperationContext() {
+    if (_cursor)
+        _cursor->reattachToOperationContext(getOpCtx());
+}
+
+void AndBitmapStage::doInvalidate(OperationContext* txn,
+                                  const RecordId& dl,
+                                  InvalidationType type) {
+    // A deleted RecordId may be reused for another document, so forget about it. A mutated
+    // document is still fetched: the FETCH above us rechecks the whole predicate.
+    if (INVALIDATION_DELETION == type) {
+        _intersection.remove(dl);
+        _probe.remove(dl);
+    }
+}
+
+unique_ptr<PlanStageStats> AndBitmapStage::getStats() {
+    _commonStats.isEOF = isEOF();
+
+    _specificStats.memLimit = _maxMemUsage;
+    _specificStats.memUsage = getMemUsage();
+
+    unique_ptr<PlanStageStats> ret = make_unique<PlanStageStats>(_commonStats, STAGE_AND_BITMAP);
+    ret->specific = make_unique<AndBitmapStats>(_specificStats);
+    for (size_t i = 0; i < _children.size(); ++i) {
+        ret->children.emplace_back(_children[i]->getStats());
+    }
+
+    return ret;
+}
+
+const SpecificStats* AndBitmapStage::getSpecificStats() const {
+    return &_specificStats;
+}
+
+}  // namespace mongo
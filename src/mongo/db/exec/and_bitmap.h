@@ -0,0 +1,134 @@
+/**
+ * Copyright (C) 2016 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/record_id_bitmap.h"
+#include "mongo/db/record_id.h"
+
+namespace mongo {
+
+class SeekableRecordCursor;
+
+/**
+ * Reads from N children, each of which must have a valid RecordId, and intersects their outputs
+ * using compressed RecordId bitmaps. Only the RecordIds are buffered: the first child's ids are
+ * added to a bitmap, and each subsequent child's ids are kept only if they are present in the
+ * intersection of the children before it. Once every child is exhausted, the stage fetches the
+ * surviving documents in RecordId order and outputs them in RID_AND_OBJ state.
+ *
+ * Because no index key data survives the intersection, this stage cannot guarantee that a
+ * document still matches its children's predicates if it changed after being read from an
+ * index. The planner therefore only uses it when the full predicate is rechecked by a FETCH
+ * above it (see QueryPlannerParams::CANNOT_TRIM_IXISECT). Deleted documents are dropped from
+ * the intersection when invalidated, or skipped when they cannot be fetched.
+ *
+ * Preconditions: Valid RecordId. More than one child.
+ */
+class AndBitmapStage final : public PlanStage {
+public:
+    AndBitmapStage(OperationContext* opCtx, WorkingSet* ws, const Collection* collection);
+
+    /**
+     * For testing only. Allows tests to set memory usage threshold.
+     */
+    AndBitmapStage(OperationContext* opCtx,
+                   WorkingSet* ws,
+                   const Collection* collection,
+                   size_t maxMemUsage);
+
+    ~AndBitmapStage();
+
+    void addChild(PlanStage* child);
+
+    /**
+     * Returns memory usage.
+     * For testing only.
+     */
+    size_t getMemUsage() const;
+
+    StageState doWork(WorkingSetID* out) final;
+    bool isEOF() final;
+
+    void doSaveState() final;
+    void doRestoreState() final;
+    void doDetachFromOperationContext() final;
+    void doReattachToOperationContext() final;
+    void doInvalidate(OperationContext* txn, const RecordId& dl, InvalidationType type) final;
+
+    StageType stageType() const final {
+        return STAGE_AND_BITMAP;
+    }
+
+    std::unique_ptr<PlanStageStats> getStats() final;
+
+    const SpecificStats* getSpecificStats() const final;
+
+    static const char* kStageType;
+
+private:
+    StageState readChild(WorkingSetID* out);
+    StageState fetchNext(WorkingSetID* out);
+
+    // Not owned by us.
+    const Collection* _collection;
+
+    // Not owned by us.
+    WorkingSet* _ws;
+
+    // Used to fetch the documents which survive the intersection.
+    std::unique_ptr<SeekableRecordCursor> _cursor;
+
+    // The intersection of the RecordIds returned by _children[0..._currentChild-1].
+    RecordIdBitmap _intersection;
+
+    // The RecordIds returned by _children[_currentChild] which are also in '_intersection'.
+    // Replaces '_intersection' once that child is EOF.
+    RecordIdBitmap _probe;
+
+    // True if we're still reading children into the bitmaps.
+    bool _readingChildren;
+
+    // Which child are we currently reading?
+    size_t _currentChild;
+
+    // While fetching, the smallest RecordId that has not yet been returned.
+    RecordId _nextRecordId;
+
+    // Stats
+    AndBitmapStats _specificStats;
+
+    // Upper limit for the memory used by the bitmaps.
+    // Defaults to 32 MB (See kDefaultMaxMemUsageBytes in and_bitmap.cpp).
+    size_t _maxMemUsage;
+};
+
+}  // namespace mongo
@@ -32,7 +32,9 @@
 
 #include "mongo/db/exec/cached_plan.h"
 
+#include "mongo/base/counter.h"
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/exec/multi_plan.h"
 #include "mongo/db/exec/scoped_timer.h"
@@ -44,12 +46,25 @@
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/stage_builder.h"
+#include "mongo/db/service_context.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 
 namespace mongo {
 
+namespace {
+
+// Once more than this many results have been returned, we stop watching for a chance to
+// replan mid-query rather than keep remembering their RecordIds.
+const size_t kMaxRecordIdsToRemember = 10000;
+
+Counter64 midQueryReplanCounter;
+ServerStatusMetricField<Counter64> displayMidQueryReplans("queryExecutor.midQueryReplans",
+                                                         &midQueryReplanCounter);
+
+}  // namespace
+
 // static
 const char* CachedPlanStage::kStageType = "CACHED_PLAN";
 
@@ -84,6 +99,10 @@ Status CachedPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
     // The trial period ends without replanning if the cached plan produces this many results.
     size_t numResults = MultiPlanStage::getTrialPeriodNumToReturn(*_canonicalQuery);
 
+    // Remember the trial period's terms, so that we can keep holding the plan to them.
+    _maxWorksBeforeReplan = maxWorksBeforeReplan;
+    _trialNumResults = numResults;
+
     for (size_t i = 0; i < maxWorksBeforeReplan; ++i) {
         // Might need to yield between calls to work due to the timer elapsing.
         Status yieldStatus = tryYield(yieldPolicy);
@@ -105,6 +124,8 @@ Status CachedPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
                 // Once a plan returns enough results, stop working. Update cache with stats
                 // from this run and return.
                 updatePlanCache();
+                _monitoringProductivity =
+                    internalQueryCacheEnableMidQueryReplanning && canReplanMidQuery();
                 return Status::OK();
             }
         } else if (PlanStage::IS_EOF == state) {
@@ -196,7 +217,9 @@ Status CachedPlanStage::tryYield(PlanYieldPolicy* yieldPolicy) {
 }
 
 Status CachedPlanStage::replan(PlanYieldPolicy* yieldPolicy, bool shouldCache) {
-    // We're going to start over with a new plan. Clear out info from our old plan.
+    // We're going to start over with a new plan. Clear out info from our old plan. When replanning
+    // mid-query, our executor has already freed every result we handed to it, so the only members
+    // left in the working set are held by the old plan tree.
     _results.clear();
     _ws->clear();
     _children.clear();
@@ -289,13 +312,101 @@ PlanStage::StageState CachedPlanStage::doWork(WorkingSetID* out) {
 
     // First exhaust any results buffered during the trial period.
     if (!_results.empty()) {
-        *out = _results.front();
+        WorkingSetID id = _results.front();
         _results.pop_front();
+        returnResult(id, out);
         return PlanStage::ADVANCED;
     }
 
     // Nothing left in trial period buffer.
-    return child()->work(out);
+    StageState state = child()->work(out);
+
+    if (PlanStage::ADVANCED == state) {
+        WorkingSetMember* member = _ws->get(*out);
+        if (_specificStats.replannedMidQuery && member->hasRecordId() &&
+            _returnedRecordIds.count(member->recordId)) {
+            // Already returned by the plan we switched away from.
+            _ws->free(*out);
+            return PlanStage::NEED_TIME;
+        }
+
+        ++_resultsInWindow;
+        returnResult(*out, out);
+    }
+
+    if (!_monitoringProductivity) {
+        return state;
+    }
+
+    // Only consider replanning between work cycles that did not hand us a working set member.
+    // The replan itself happens in replanMidQuery(), outside of work(), so that the new plan's
+    // trial period can yield.
+    if (++_worksInWindow >= _maxWorksBeforeReplan && PlanStage::NEED_TIME == state) {
+        if (_resultsInWindow < _trialNumResults) {
+            _monitoringProductivity = false;
+            _needsMidQueryReplan = true;
+            return state;
+        }
+        _worksInWindow = 0;
+        _resultsInWindow = 0;
+    }
+
+    return state;
+}
+
+bool CachedPlanStage::canReplanMidQuery() const {
+    // Only a find's executor is guaranteed to have this stage as its root, with no parent stage
+    // which writes or holds on to working set members across calls to work().
+    if (!(_plannerParams.options & QueryPlannerParams::PRIVATE_IS_FIND)) {
+        return false;
+    }
+
+    // Storage engines without document-level locking may move a document to a new RecordId
+    // while we are yielded.
+    if (!supportsDocLocking()) {
+        return false;
+    }
+
+    const LiteParsedQuery& parsed = _canonicalQuery->getParsed();
+    return parsed.getSort().isEmpty() && !parsed.getSkip() && !parsed.getLimit() &&
+        !parsed.getNToReturn();
+}
+
+void CachedPlanStage::returnResult(WorkingSetID id, WorkingSetID* out) {
+    if (_monitoringProductivity) {
+        WorkingSetMember* member = _ws->get(id);
+        if (!member->hasRecordId() || _returnedRecordIds.size() >= kMaxRecordIdsToRemember) {
+            // We could no longer tell the results already returned apart from a new plan's.
+            _monitoringProductivity = false;
+            _returnedRecordIds.clear();
+        } else {
+            _returnedRecordIds.insert(member->recordId);
+        }
+    }
+
+    *out = id;
+}
+
+Status CachedPlanStage::replanMidQuery(PlanYieldPolicy* yieldPolicy) {
+    invariant(_needsMidQueryReplan);
+    invariant(_results.empty());
+
+    // Adds the amount of time taken by replanning to executionTimeMillis.
+    ScopedTimer timer(&_commonStats.executionTimeMillis);
+
+    LOG(1) << "Cached plan produced " << _resultsInWindow << " results in " << _worksInWindow
+           << " works, but was originally cached producing " << _trialNumResults
+           << " results within " << _maxWorksBeforeReplan
+           << " works. Evicting cache entry and replanning query mid-execution: "
+           << _canonicalQuery->toStringShort()
+           << " plan summary before replan: " << Explain::getPlanSummary(child().get());
+
+    _needsMidQueryReplan = false;
+    _specificStats.replannedMidQuery = true;
+    midQueryReplanCounter.increment();
+
+    const bool shouldCache = true;
+    return replan(yieldPolicy, shouldCache);
 }
 
 void CachedPlanStage::doInvalidate(OperationContext* txn,
@@ -39,6 +39,7 @@
 #include "mongo/db/query/query_solution.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/record_fetcher.h"
+#include "mongo/platform/unordered_set.h"
 
 namespace mongo {
 
@@ -48,6 +49,13 @@ class PlanYieldPolicy;
  * This stage outputs its mainChild, and possibly its backup child
  * and also updates the cache.
  *
+ * After the trial period, the stage keeps comparing the cached plan's productivity with the
+ * productivity it needed to survive the trial period. If the plan falls below it for a whole
+ * window of 'internalQueryCacheEvictionRatio * decisionWorks' works, the stage asks to be
+ * replanned mid-stream (see needsMidQueryReplan()). Results returned before the switch are
+ * remembered by RecordId and skipped when the new plan produces them again, so this is only done
+ * when such deduplication is sound (see canReplanMidQuery()).
+ *
  * Preconditions: Valid RecordId.
  *
  */
@@ -87,6 +95,24 @@ public:
      */
     Status pickBestPlan(PlanYieldPolicy* yieldPolicy);
 
+    /**
+     * Returns true if the cached plan fell behind its expected productivity after the trial
+     * period, and the query should be replanned with replanMidQuery() before the next call to
+     * work(). Until then, work() keeps running the cached plan.
+     */
+    bool needsMidQueryReplan() const {
+        return _needsMidQueryReplan;
+    }
+
+    /**
+     * Discards the cached plan and replans the query, yielding during the new plan's trial period
+     * according to 'yieldPolicy'. Must only be called by the PlanExecutor which has this stage as
+     * its root, between calls to work(), once needsMidQueryReplan() returns true.
+     *
+     * Returns a non-OK status if replanning failed or the plan was killed during a yield.
+     */
+    Status replanMidQuery(PlanYieldPolicy* yieldPolicy);
+
 private:
     /**
      * Passes stats from the trial period run of the cached plan to the plan cache.
@@ -107,6 +133,20 @@ private:
      */
     Status replan(PlanYieldPolicy* yieldPolicy, bool shouldCache);
 
+    /**
+     * Returns true if this query may switch to a new plan after results have been returned:
+     * this stage must be the root of a find, the results must come back in no particular order,
+     * must not be skipped or limited by count, and must be identified by RecordIds which do not
+     * change while the query runs.
+     */
+    bool canReplanMidQuery() const;
+
+    /**
+     * Hands the result 'id' to the caller, remembering its RecordId in case we later replan
+     * mid-query.
+     */
+    void returnResult(WorkingSetID id, WorkingSetID* out);
+
     /**
      * May yield during the cached plan stage's trial period or replanning phases.
      *
@@ -142,6 +182,26 @@ private:
     // just pass a NULL fetcher.
     std::unique_ptr<RecordFetcher> _fetcher;
 
+    // The cached plan had to produce '_trialNumResults' results within '_maxWorksBeforeReplan'
+    // works to survive the trial period. After the trial period it is held to the same rate.
+    size_t _maxWorksBeforeReplan = 0;
+    size_t _trialNumResults = 0;
+
+    // True while we are still checking whether the cached plan should be replaced mid-query.
+    bool _monitoringProductivity = false;
+
+    // True once the cached plan fell behind and is waiting to be replaced by replanMidQuery().
+    bool _needsMidQueryReplan = false;
+
+    // Work cycles and results of the cached plan since its productivity was last checked.
+    size_t _worksInWindow = 0;
+    size_t _resultsInWindow = 0;
+
+    // RecordIds of the results handed to our caller so far. Only populated while
+    // '_monitoringProductivity' is true, and used after a mid-query replan to avoid returning
+    // the same document twice.
+    unordered_set<RecordId, RecordId::Hasher> _returnedRecordIds;
+
     // Stats
     CachedPlanStats _specificStats;
 };
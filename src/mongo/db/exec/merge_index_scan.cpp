@@ -0,0 +1,400 @@
+/**
+ * Copyright (C) 2016 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/merge_index_scan.h"
+
+#include <limits>
+
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/exec/filter.h"
+#include "mongo/db/exec/scoped_timer.h"
+#include "mongo/db/exec/working_set_computed_data.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/log.h"
+
+namespace mongo {
+
+// static
+const char* MergeIndexScan::kStageType = "MERGE_IXSCAN";
+
+// static
+const size_t MergeIndexScan::kInvalidSubScan = std::numeric_limits<size_t>::max();
+
+MergeIndexScan::MergeIndexScan(OperationContext* txn,
+                               const IndexScanParams& params,
+                               size_t numPointPrefixFields,
+                               WorkingSet* workingSet,
+                               const MatchExpression* filter)
+    : PlanStage(kStageType, txn),
+      _workingSet(workingSet),
+      _iam(params.descriptor->getIndexCatalog()->getIndex(params.descriptor)),
+      _keyPattern(params.descriptor->keyPattern().getOwned()),
+      _ordering(Ordering::make(_keyPattern)),
+      _filter(filter),
+      _params(params),
+      _numPointPrefixFields(numPointPrefixFields),
+      _forward(params.direction == 1),
+      _shouldDedup(true),
+      _nextSubScanToInit(0),
+      _subScanToAdvance(kInvalidSubScan),
+      _cursorOwner(kInvalidSubScan),
+      _merging(HeadGreater(this)),
+      _hitMaxScan(false),
+      _numRestores(0) {
+    invariant(!_params.bounds.isSimpleRange);
+    invariant(_numPointPrefixFields > 0);
+    invariant(_numPointPrefixFields < _params.bounds.fields.size());
+
+    // We can't always access the descriptor in the call to getStats() so we pull
+    // any info we need for stats reporting out here.
+    _specificStats.keyPattern = _keyPattern;
+    _specificStats.indexName = _params.descriptor->indexName();
+    _specificStats.isMultiKey = _params.descriptor->isMultikey(getOpCtx());
+    _specificStats.isUnique = _params.descriptor->unique();
+    _specificStats.isSparse = _params.descriptor->isSparse();
+    _specificStats.isPartial = _params.descriptor->isPartial();
+    _specificStats.indexVersion = _params.descriptor->version();
+}
+
+bool MergeIndexScan::HeadGreater::operator()(size_t lhs, size_t rhs) const {
+    BSONObjIterator lhsIt(_stage->_subScans[lhs]->head.key);
+    BSONObjIterator rhsIt(_stage->_subScans[rhs]->head.key);
+
+    // The point prefix fields differ between sub-scans by construction and do not contribute to
+    // the sort order.
+    for (size_t i = 0; lhsIt.more() && rhsIt.more(); ++i) {
+        BSONElement lhsElt = lhsIt.next();
+        BSONElement rhsElt = rhsIt.next();
+        if (i < _stage->_numPointPrefixFields) {
+            continue;
+        }
+
+        int cmp = lhsElt.woCompare(rhsElt, false) * _stage->_ordering.get(i);
+        if (cmp != 0) {
+            return _stage->_forward ? cmp > 0 : cmp < 0;
+        }
+    }
+
+    return lhs > rhs;
+}
+
+void MergeIndexScan::initSubScans() {
+    if (_params.doNotDedup) {
+        _shouldDedup = false;
+    } else {
+        // TODO it is incorrect to rely on this not changing. SERVER-17678
+        _shouldDedup = _params.descriptor->isMultikey(getOpCtx());
+    }
+
+    _indexCursor = _iam->newCursor(getOpCtx(), _forward);
+
+    const IndexBounds& bounds = _params.bounds;
+    for (size_t i = 0; i < _numPointPrefixFields; ++i) {
+        if (bounds.fields[i].intervals.empty()) {
+            return;
+        }
+    }
+
+    // Build one sub-scan per element of the Cartesian product of the point prefix intervals,
+    // stepping through the product like an odometer.
+    std::vector<size_t> position(_numPointPrefixFields, 0);
+    while (true) {
+        auto subScan = stdx::make_unique<SubScan>();
+        subScan->bounds.fields.resize(bounds.fields.size());
+        for (size_t i = 0; i < bounds.fields.size(); ++i) {
+            if (i < _numPointPrefixFields) {
+                subScan->bounds.fields[i].name = bounds.fields[i].name;
+                subScan->bounds.fields[i].intervals.push_back(
+                    bounds.fields[i].intervals[position[i]]);
+            } else {
+                subScan->bounds.fields[i] = bounds.fields[i];
+            }
+        }
+
+        subScan->checker = stdx::make_unique<IndexBoundsChecker>(
+            &subScan->bounds, _keyPattern, _params.direction);
+
+        // Sub-scans whose bounds cannot match anything are not needed.
+        if (subScan->checker->getStartSeekPoint(&subScan->seekPoint)) {
+            _subScans.push_back(std::move(subScan));
+        }
+
+        size_t field = _numPointPrefixFields;
+        while (field > 0 && ++position[field - 1] == bounds.fields[field - 1].intervals.size()) {
+            position[field - 1] = 0;
+            --field;
+        }
+
+        if (field == 0) {
+            break;
+        }
+    }
+}
+
+boost::optional<IndexKeyEntry> MergeIndexScan::nextEntry(size_t index, SubScan* subScan) {
+    if (subScan->needSeek) {
+        ++_specificStats.seeks;
+        return _indexCursor->seek(subScan->seekPoint);
+    }
+
+    if (_cursorOwner == index) {
+        return _indexCursor->next();
+    }
+
+    // The cursor has moved on to another sub-scan since we read 'head'. Seek back to the first
+    // entry with the same key and step over the entries up to and including 'head'. Entries with
+    // equal keys are ordered by RecordId, so this works even if 'head' has since been deleted.
+    ++_specificStats.seeks;
+    const IndexKeyEntry& last = subScan->head;
+    boost::optional<IndexKeyEntry> kv = _indexCursor->seek(last.key, /*inclusive*/ true);
+    while (kv && 0 == kv->key.woCompare(last.key, _ordering, /*considerFieldName*/ false) &&
+           (_forward ? kv->loc <= last.loc : kv->loc >= last.loc)) {
+        ++_specificStats.keysExamined;
+        kv = _indexCursor->next();
+    }
+    return kv;
+}
+
+bool MergeIndexScan::advanceSubScan(size_t index) {
+    SubScan* subScan = _subScans[index].get();
+
+    boost::optional<IndexKeyEntry> kv = nextEntry(index, subScan);
+    _cursorOwner = index;
+
+    if (kv) {
+        ++_specificStats.keysExamined;
+        if (_params.maxScan && _specificStats.keysExamined >= _params.maxScan) {
+            _hitMaxScan = true;
+            kv = boost::none;
+        }
+    }
+
+    if (kv) {
+        switch (subScan->checker->checkKey(kv->key, &subScan->seekPoint)) {
+            case IndexBoundsChecker::VALID:
+                break;
+
+            case IndexBoundsChecker::DONE:
+                kv = boost::none;
+                break;
+
+            case IndexBoundsChecker::MUST_ADVANCE:
+                subScan->needSeek = true;
+                return false;
+        }
+    }
+
+    subScan->needSeek = false;
+    if (!kv) {
+        // This sub-scan is exhausted.
+        return true;
+    }
+
+    subScan->head = IndexKeyEntry(kv->key.getOwned(), kv->loc);
+    subScan->headRestoreCount = _numRestores;
+    subScan->headDeleted = false;
+    subScan->headMutated = false;
+    _merging.push(index);
+    return true;
+}
+
+PlanStage::StageState MergeIndexScan::doWork(WorkingSetID* out) {
+    if (isEOF()) {
+        return PlanStage::IS_EOF;
+    }
+
+    try {
+        if (!_indexCursor) {
+            initSubScans();
+        }
+
+        // Finish moving the sub-scan whose head we last returned, or which we are positioning
+        // for the first time.
+        if (_subScanToAdvance != kInvalidSubScan) {
+            if (!advanceSubScan(_subScanToAdvance)) {
+                return PlanStage::NEED_TIME;
+            }
+            _subScanToAdvance = kInvalidSubScan;
+        }
+
+        // Every sub-scan must have a head before we know which result comes first. Position one
+        // sub-scan per call to work() so that we can yield in between.
+        if (!_hitMaxScan && _nextSubScanToInit < _subScans.size()) {
+            _subScanToAdvance = _nextSubScanToInit++;
+            return PlanStage::NEED_TIME;
+        }
+    } catch (const WriteConflictException& wce) {
+        *out = WorkingSet::INVALID_ID;
+        return PlanStage::NEED_YIELD;
+    }
+
+    if (_hitMaxScan || _merging.empty()) {
+        _commonStats.isEOF = true;
+        _indexCursor.reset();
+        return PlanStage::IS_EOF;
+    }
+
+    const size_t index = _merging.top();
+    _merging.pop();
+
+    // The sub-scan is advanced past 'head' on the next call to work().
+    _subScanToAdvance = index;
+    const SubScan& subScan = *_subScans[index];
+    const IndexKeyEntry& kv = subScan.head;
+
+    if (subScan.headDeleted) {
+        return PlanStage::NEED_TIME;
+    }
+
+    if (_shouldDedup) {
+        ++_specificStats.dupsTested;
+        if (!_returned.insert(kv.loc).second) {
+            // We've seen this RecordId before. Skip it this time.
+            ++_specificStats.dupsDropped;
+            return PlanStage::NEED_TIME;
+        }
+    }
+
+    if (_filter) {
+        if (!Filter::passes(kv.key, _keyPattern, _filter)) {
+            return PlanStage::NEED_TIME;
+        }
+    }
+
+    // We found something to return, so fill out the WSM.
+    WorkingSetID id = _workingSet->allocate();
+    WorkingSetMember* member = _workingSet->get(id);
+    member->recordId = kv.loc;
+    member->keyData.push_back(IndexKeyDatum(_keyPattern, kv.key, _iam));
+    _workingSet->transitionToRecordIdAndIdx(id);
+
+    // The key was read before a yield, so the document may no longer match it.
+    if (subScan.headMutated || subScan.headRestoreCount != _numRestores) {
+        member->isSuspicious = true;
+    }
+
+    if (_params.addKeyMetadata) {
+        BSONObjBuilder bob;
+        bob.appendKeys(_keyPattern, kv.key);
+        member->addComputed(new IndexKeyComputedData(bob.obj()));
+    }
+
+    *out = id;
+    return PlanStage::ADVANCED;
+}
+
+bool MergeIndexScan::isEOF() {
+    return _commonStats.isEOF;
+}
+
+void MergeIndexScan::doSaveState() {
+    // Sub-scans always seek back to their own position after a yield, so the cursor does not
+    // need to remember where it was.
+    if (_indexCursor) {
+        _indexCursor->saveUnpositioned();
+    }
+}
+
+void MergeIndexScan::doRestoreState() {
+    if (_indexCursor) {
+        _indexCursor->restore();
+    }
+    _cursorOwner = kInvalidSubScan;
+    ++_numRestores;
+}
+
+void MergeIndexScan::doDetachFromOperationContext() {
+    if (_indexCursor)
+        _indexCursor->detachFromOperationContext();
+}
+
+void MergeIndexScan::doReattachToOperationContext() {
+    if (_indexCursor)
+        _indexCursor->reattachToOperationContext(getOpCtx());
+}
+
+void MergeIndexScan::doInvalidate(OperationContext* txn,
+                                  const RecordId& dl,
+                                  InvalidationType type) {
+    // Go through the buffered heads and see if we're holding on to the invalidated RecordId.
+    for (auto&& subScan : _subScans) {
+        if (subScan->head.loc == dl) {
+            if (INVALIDATION_DELETION == type) {
+                subScan->headDeleted = true;
+            } else {
+                subScan->headMutated = true;
+            }
+        }
+    }
+
+    // If we see the deleted RecordId again, it may not be the same document it was before, so we
+    // want to return it if we see it again.
+    if (INVALIDATION_DELETION == type) {
+        auto it = _returned.find(dl);
+        if (it != _returned.end()) {
+            ++_specificStats.seenInvalidated;
+            _returned.erase(it);
+        }
+    }
+}
+
+std::unique_ptr<PlanStageStats> MergeIndexScan::getStats() {
+    // WARNING: this could be called even if the collection was dropped.  Do not access any
+    // catalog information here.
+
+    // Add a BSON representation of the filter to the stats tree, if there is one.
+    if (NULL != _filter) {
+        BSONObjBuilder bob;
+        _filter->toBSON(&bob);
+        _commonStats.filter = bob.obj();
+    }
+
+    // These specific stats fields never change.
+    if (_specificStats.indexType.empty()) {
+        _specificStats.indexType = "BtreeCursor";
+        _specificStats.indexBounds = _params.bounds.toBSON();
+        _specificStats.direction = _params.direction;
+    }
+
+    std::unique_ptr<PlanStageStats> ret =
+        stdx::make_unique<PlanStageStats>(_commonStats, STAGE_MERGE_IXSCAN);
+    ret->specific = stdx::make_unique<IndexScanStats>(_specificStats);
+    return ret;
+}
+
+const SpecificStats* MergeIndexScan::getSpecificStats() const {
+    return &_specificStats;
+}
+
+}  // namespace mongo
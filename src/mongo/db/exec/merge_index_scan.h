@@ -0,0 +1,192 @@
+/**
+ * Copyright (C) 2016 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <queue>
+#include <vector>
+
+#include "mongo/db/exec/index_scan.h"
+#include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/query/index_bounds.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/index_entry_comparison.h"
+#include "mongo/db/storage/sorted_data_interface.h"
+#include "mongo/platform/unordered_set.h"
+
+namespace mongo {
+
+class IndexAccessMethod;
+class WorkingSet;
+
+/**
+ * Scans an index whose leading 'numPointPrefixFields' fields are bounded by unions of point
+ * intervals, and returns the results sorted by the remaining fields of the index key.
+ *
+ * This is logically equivalent to a MergeSortStage over one IndexScan per combination of the
+ * prefix points, but the sub-scans share a single index cursor and hold no more state than their
+ * bounds and the next key they will return. The sub-scans are merged with a heap; whenever the
+ * next result comes from a different sub-scan than the previous one, the cursor seeks back to
+ * that sub-scan's position. This lets a sort be provided by the index for $in lists that would
+ * be too expensive to explode into separate index scan stages.
+ *
+ * Internally dedups on RecordId if the index is multikey.
+ *
+ * Sub-stage preconditions: None.  Is a leaf and consumes no stage data.
+ */
+class MergeIndexScan final : public PlanStage {
+public:
+    MergeIndexScan(OperationContext* txn,
+                   const IndexScanParams& params,
+                   size_t numPointPrefixFields,
+                   WorkingSet* workingSet,
+                   const MatchExpression* filter);
+
+    StageState doWork(WorkingSetID* out) final;
+    bool isEOF() final;
+    void doSaveState() final;
+    void doRestoreState() final;
+    void doDetachFromOperationContext() final;
+    void doReattachToOperationContext() final;
+    void doInvalidate(OperationContext* txn, const RecordId& dl, InvalidationType type) final;
+
+    StageType stageType() const final {
+        return STAGE_MERGE_IXSCAN;
+    }
+
+    std::unique_ptr<PlanStageStats> getStats() final;
+
+    const SpecificStats* getSpecificStats() const final;
+
+    static const char* kStageType;
+
+private:
+    /**
+     * The scan over one combination of the point prefix values.
+     */
+    struct SubScan {
+        IndexBounds bounds;
+        std::unique_ptr<IndexBoundsChecker> checker;
+
+        // Where to seek to when 'needSeek' is true.
+        IndexSeekPoint seekPoint;
+        bool needSeek = true;
+
+        // The next entry this sub-scan will return. Only meaningful while the sub-scan is in the
+        // merge heap.
+        IndexKeyEntry head{BSONObj(), RecordId()};
+
+        // The value of '_numRestores' when 'head' was read. If the stage has yielded since, the
+        // index entry may no longer describe the document by the time it is returned.
+        size_t headRestoreCount = 0;
+
+        // Set if the document 'head' refers to was deleted or mutated while buffered.
+        bool headDeleted = false;
+        bool headMutated = false;
+    };
+
+    /**
+     * Orders sub-scans in the merge heap by their head keys, ignoring the point prefix fields.
+     * Ties are broken by sub-scan index so that each run of equal keys is drained from one
+     * sub-scan before moving to the next, which keeps the cursor positioned on that sub-scan.
+     */
+    class HeadGreater {
+    public:
+        explicit HeadGreater(const MergeIndexScan* stage) : _stage(stage) {}
+        bool operator()(size_t lhs, size_t rhs) const;
+
+    private:
+        const MergeIndexScan* _stage;
+    };
+
+    /**
+     * Creates the cursor and one sub-scan per combination of the point prefix intervals.
+     */
+    void initSubScans();
+
+    /**
+     * Moves the sub-scan at 'index' to its next entry within bounds and, if there is one, adds it
+     * to the merge heap. Returns false if the sub-scan must seek before it can make progress, in
+     * which case this should be called again on the next call to work().
+     */
+    bool advanceSubScan(size_t index);
+
+    /**
+     * Returns the next index entry for 'subScan', which has index 'index', repositioning the
+     * shared cursor if necessary.
+     */
+    boost::optional<IndexKeyEntry> nextEntry(size_t index, SubScan* subScan);
+
+    static const size_t kInvalidSubScan;
+
+    // The WorkingSet we fill with results.  Not owned by us.
+    WorkingSet* const _workingSet;
+
+    // Index access.
+    const IndexAccessMethod* const _iam;  // owned by Collection -> IndexCatalog
+    std::unique_ptr<SortedDataInterface::Cursor> _indexCursor;
+    const BSONObj _keyPattern;
+    const Ordering _ordering;
+
+    // Contains expressions only over fields in the index key.  Not owned by us.
+    const MatchExpression* const _filter;
+
+    const IndexScanParams _params;
+    const size_t _numPointPrefixFields;
+    const bool _forward;
+
+    // Could our index have duplicates?  If so, we use _returned to dedup.
+    bool _shouldDedup;
+    unordered_set<RecordId, RecordId::Hasher> _returned;
+
+    std::vector<std::unique_ptr<SubScan>> _subScans;
+
+    // Sub-scans which have not yet been positioned for the first time start at this index.
+    size_t _nextSubScanToInit;
+
+    // The sub-scan which must be advanced before the next result can be determined.
+    size_t _subScanToAdvance;
+
+    // The sub-scan whose last entry is the current position of '_indexCursor'.
+    size_t _cursorOwner;
+
+    // Indices into '_subScans' for every sub-scan with a head, smallest head on top.
+    std::priority_queue<size_t, std::vector<size_t>, HeadGreater> _merging;
+
+    bool _hitMaxScan;
+
+    // Number of times the stage has been restored after yielding.
+    size_t _numRestores;
+
+    // Stats
+    IndexScanStats _specificStats;
+};
+
+}  // namespace mongo
@@ -47,6 +47,7 @@
 #include "mongo/db/query/plan_ranker.h"
 #include "mongo/db/storage/record_fetcher.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/util/fail_point_service.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/log.h"
 
@@ -58,6 +59,9 @@ using std::unique_ptr;
 using std::vector;
 using stdx::make_unique;
 
+// Makes a candidate plan report a write conflict instead of doing a unit of work.
+MONGO_FP_DECLARE(multiPlanStageWriteConflict);
+
 // static
 const char* MultiPlanStage::kStageType = "MULTI_PLAN";
 
@@ -344,7 +348,9 @@ bool MultiPlanStage::workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolic
         }
 
         WorkingSetID id = WorkingSet::INVALID_ID;
-        PlanStage::StageState state = candidate.root->work(&id);
+        PlanStage::StageState state = MONGO_FAIL_POINT(multiPlanStageWriteConflict)
+            ? PlanStage::NEED_YIELD
+            : candidate.root->work(&id);
 
         if (PlanStage::ADVANCED == state) {
             // Save result for later.
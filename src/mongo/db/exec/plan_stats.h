@@ -137,6 +137,30 @@ private:
     MONGO_DISALLOW_COPYING(PlanStageStats);
 };
 
+struct AndBitmapStats : public SpecificStats {
+    AndBitmapStats() : docsFetched(0), memUsage(0), memLimit(0) {}
+
+    SpecificStats* clone() const final {
+        AndBitmapStats* specific = new AndBitmapStats(*this);
+        return specific;
+    }
+
+    // How many RecordIds are in the intersection after each child?
+    // child 'i' produced children[i].common.advanced RecordIds, of which
+    // intersectionAfterChild[i] were in the intersection of all previous children.
+    std::vector<size_t> intersectionAfterChild;
+
+    // How many of the surviving RecordIds were fetched? This can be smaller than the last entry
+    // of 'intersectionAfterChild' if documents were deleted or the stage did not run to EOF.
+    size_t docsFetched;
+
+    // What's our current memory usage?
+    size_t memUsage;
+
+    // What's our memory limit?
+    size_t memLimit;
+};
+
 struct AndHashStats : public SpecificStats {
     AndHashStats() : flaggedButPassed(0), flaggedInProgress(0), memUsage(0), memLimit(0) {}
 
@@ -183,13 +207,16 @@ struct AndSortedStats : public SpecificStats {
 };
 
 struct CachedPlanStats : public SpecificStats {
-    CachedPlanStats() : replanned(false) {}
+    CachedPlanStats() : replanned(false), replannedMidQuery(false) {}
 
     SpecificStats* clone() const final {
         return new CachedPlanStats(*this);
     }
 
     bool replanned;
+
+    // Did we switch away from the cached plan after it had started returning results?
+    bool replannedMidQuery;
 };
 
 struct CollectionScanStats : public SpecificStats {
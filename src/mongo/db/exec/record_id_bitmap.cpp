@@ -0,0 +1,246 @@
+/**
+ * Copyright (C) 2016 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_bitmap.h"
+
+#include <algorithm>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+namespace {
+
+// Approximate bookkeeping cost of one entry in the map of containers.
+const size_t kPerContainerOverhead = 64;
+
+}  // namespace
+
+const size_t RecordIdBitmap::kMaxArrayContainerSize = 4096;
+
+bool RecordIdBitmap::Container::add(uint16_t low) {
+    if (isBitmap()) {
+        uint64_t& word = _bits[low / 64];
+        const uint64_t mask = uint64_t(1) << (low % 64);
+        if (word & mask) {
+            return false;
+        }
+        word |= mask;
+        ++_size;
+        return true;
+    }
+
+    auto it = std::lower_bound(_array.begin(), _array.end(), low);
+    if (it != _array.end() && *it == low) {
+        return false;
+    }
+    _array.insert(it, low);
+    ++_size;
+
+    if (_size > kMaxArrayContainerSize) {
+        convertToBitmap();
+    }
+    return true;
+}
+
+bool RecordIdBitmap::Container::remove(uint16_t low) {
+    if (isBitmap()) {
+        uint64_t& word = _bits[low / 64];
+        const uint64_t mask = uint64_t(1) << (low % 64);
+        if (!(word & mask)) {
+            return false;
+        }
+        word &= ~mask;
+        --_size;
+
+        // Only go back to an array well below the conversion threshold, so that a container
+        // hovering around the threshold is not repeatedly converted back and forth.
+        if (_size < kMaxArrayContainerSize / 2) {
+            convertToArray();
+        }
+        return true;
+    }
+
+    auto it = std::lower_bound(_array.begin(), _array.end(), low);
+    if (it == _array.end() || *it != low) {
+        return false;
+    }
+    _array.erase(it);
+    --_size;
+    return true;
+}
+
+bool RecordIdBitmap::Container::contains(uint16_t low) const {
+    if (isBitmap()) {
+        return _bits[low / 64] & (uint64_t(1) << (low % 64));
+    }
+    return std::binary_search(_array.begin(), _array.end(), low);
+}
+
+bool RecordIdBitmap::Container::lowerBound(uint32_t start, uint16_t* out) const {
+    if (start > 0xFFFF) {
+        return false;
+    }
+
+    if (!isBitmap()) {
+        auto it = std::lower_bound(_array.begin(), _array.end(), static_cast<uint16_t>(start));
+        if (it == _array.end()) {
+            return false;
+        }
+        *out = *it;
+        return true;
+    }
+
+    size_t wordIdx = start / 64;
+    // Mask off the bits below 'start' in the first word examined.
+    uint64_t word = _bits[wordIdx] & (~uint64_t(0) << (start % 64));
+    while (true) {
+        if (word) {
+            size_t bit = 0;
+            while (!(word & (uint64_t(1) << bit))) {
+                ++bit;
+            }
+            *out = static_cast<uint16_t>(wordIdx * 64 + bit);
+            return true;
+        }
+        if (++wordIdx == kBitmapWords) {
+            return false;
+        }
+        word = _bits[wordIdx];
+    }
+}
+
+size_t RecordIdBitmap::Container::getMemUsage() const {
+    return isBitmap() ? _bits.size() * sizeof(uint64_t) : _array.capacity() * sizeof(uint16_t);
+}
+
+void RecordIdBitmap::Container::convertToBitmap() {
+    invariant(!isBitmap());
+    _bits.assign(kBitmapWords, 0);
+    for (uint16_t low : _array) {
+        _bits[low / 64] |= uint64_t(1) << (low % 64);
+    }
+    std::vector<uint16_t>().swap(_array);
+}
+
+void RecordIdBitmap::Container::convertToArray() {
+    invariant(isBitmap());
+    _array.reserve(_size);
+    for (size_t wordIdx = 0; wordIdx < kBitmapWords; ++wordIdx) {
+        uint64_t word = _bits[wordIdx];
+        for (size_t bit = 0; word; ++bit, word >>= 1) {
+            if (word & 1) {
+                _array.push_back(static_cast<uint16_t>(wordIdx * 64 + bit));
+            }
+        }
+    }
+    std::vector<uint64_t>().swap(_bits);
+}
+
+bool RecordIdBitmap::add(const RecordId& id) {
+    auto it = _containers.find(highBits(id));
+    if (it == _containers.end()) {
+        it = _containers.insert(std::make_pair(highBits(id), Container())).first;
+        _memUsage += kPerContainerOverhead;
+    }
+
+    Container& container = it->second;
+    const size_t memUsageBefore = container.getMemUsage();
+    if (!container.add(lowBits(id))) {
+        return false;
+    }
+
+    ++_size;
+    _memUsage -= memUsageBefore;
+    _memUsage += container.getMemUsage();
+    return true;
+}
+
+bool RecordIdBitmap::remove(const RecordId& id) {
+    auto it = _containers.find(highBits(id));
+    if (it == _containers.end()) {
+        return false;
+    }
+
+    Container& container = it->second;
+    const size_t memUsageBefore = container.getMemUsage();
+    if (!container.remove(lowBits(id))) {
+        return false;
+    }
+
+    --_size;
+    _memUsage -= memUsageBefore;
+    if (container.size() == 0) {
+        _containers.erase(it);
+        _memUsage -= kPerContainerOverhead;
+    } else {
+        _memUsage += container.getMemUsage();
+    }
+    return true;
+}
+
+bool RecordIdBitmap::contains(const RecordId& id) const {
+    auto it = _containers.find(highBits(id));
+    return it != _containers.end() && it->second.contains(lowBits(id));
+}
+
+bool RecordIdBitmap::lowerBound(const RecordId& start, RecordId* out) const {
+    const int64_t high = highBits(start);
+    uint32_t low = lowBits(start);
+
+    for (auto it = _containers.lower_bound(high); it != _containers.end(); ++it) {
+        if (it->first != high) {
+            // Every member of a later container is greater than 'start'.
+            low = 0;
+        }
+
+        uint16_t found;
+        if (it->second.lowerBound(low, &found)) {
+            *out = RecordId(static_cast<int64_t>((static_cast<uint64_t>(it->first) << 16) | found));
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void RecordIdBitmap::clear() {
+    _containers.clear();
+    _size = 0;
+    _memUsage = 0;
+}
+
+void RecordIdBitmap::swap(RecordIdBitmap& other) {
+    _containers.swap(other._containers);
+    std::swap(_size, other._size);
+    std::swap(_memUsage, other._memUsage);
+}
+
+}  // namespace mongo
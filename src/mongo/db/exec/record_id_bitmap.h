@@ -0,0 +1,156 @@
+/**
+ * Copyright (C) 2016 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "mongo/db/record_id.h"
+
+namespace mongo {
+
+/**
+ * A compressed set of RecordIds, organized in the style of a roaring bitmap.
+ *
+ * The 64-bit RecordId space is split into chunks of 2^16 consecutive ids keyed by the high 48
+ * bits of the id. Each chunk stores the low 16 bits of its members either as a sorted array of
+ * uint16_t, while the chunk is sparse, or as a fixed-size 8KB bitmap once it holds more than
+ * kMaxArrayContainerSize ids. Dense runs of RecordIds, as produced by collections with
+ * monotonically increasing ids, therefore cost about one bit per member instead of the several
+ * dozen bytes per member of a hash table.
+ *
+ * Iteration is in ascending RecordId order.
+ */
+class RecordIdBitmap {
+public:
+    /**
+     * A chunk holding more than this many ids is stored as a bitmap rather than an array. At this
+     * size both representations use 8KB.
+     */
+    static const size_t kMaxArrayContainerSize;
+
+    RecordIdBitmap() = default;
+
+    /**
+     * Adds 'id' to the set. Returns false if it was already present.
+     */
+    bool add(const RecordId& id);
+
+    /**
+     * Removes 'id' from the set. Returns false if it was not present.
+     */
+    bool remove(const RecordId& id);
+
+    bool contains(const RecordId& id) const;
+
+    /**
+     * Finds the smallest member that is greater than or equal to 'start'. Returns false if there
+     * is no such member.
+     *
+     * This is used instead of an iterator so that callers may remove members between calls.
+     */
+    bool lowerBound(const RecordId& start, RecordId* out) const;
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    void clear();
+
+    void swap(RecordIdBitmap& other);
+
+    /**
+     * Returns the approximate number of bytes used to hold the members of this set.
+     */
+    size_t getMemUsage() const {
+        return _memUsage;
+    }
+
+private:
+    /**
+     * Holds the low 16 bits of every member sharing the same high 48 bits.
+     */
+    class Container {
+    public:
+        bool add(uint16_t low);
+        bool remove(uint16_t low);
+        bool contains(uint16_t low) const;
+
+        /**
+         * Finds the smallest member that is greater than or equal to 'start'.
+         */
+        bool lowerBound(uint32_t start, uint16_t* out) const;
+
+        size_t size() const {
+            return _size;
+        }
+
+        size_t getMemUsage() const;
+
+    private:
+        static const size_t kBitmapWords = (1 << 16) / 64;
+
+        bool isBitmap() const {
+            return !_bits.empty();
+        }
+
+        void convertToBitmap();
+        void convertToArray();
+
+        // Exactly one of these is in use: '_array' while the container is sparse, '_bits' (with
+        // kBitmapWords words) once it is dense.
+        std::vector<uint16_t> _array;
+        std::vector<uint64_t> _bits;
+
+        size_t _size = 0;
+    };
+
+    static int64_t highBits(const RecordId& id) {
+        return id.repr() >> 16;
+    }
+
+    static uint16_t lowBits(const RecordId& id) {
+        return static_cast<uint16_t>(id.repr() & 0xFFFF);
+    }
+
+    std::map<int64_t, Container> _containers;
+
+    // Total number of members across all containers.
+    size_t _size = 0;
+
+    // Sum of the memory used by all containers, plus a fixed per-container overhead.
+    size_t _memUsage = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,149 @@
+/**
+ * Copyright (C) 2016 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+/**
+ * This file contains tests for mongo/db/exec/record_id_bitmap.cpp
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_bitmap.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(RecordIdBitmapTest, EmptyBitmap) {
+    RecordIdBitmap bitmap;
+    ASSERT(bitmap.empty());
+    ASSERT_EQUALS(0U, bitmap.size());
+    ASSERT_FALSE(bitmap.contains(RecordId(1)));
+    ASSERT_FALSE(bitmap.remove(RecordId(1)));
+
+    RecordId out;
+    ASSERT_FALSE(bitmap.lowerBound(RecordId::min(), &out));
+}
+
+TEST(RecordIdBitmapTest, AddContainsRemove) {
+    RecordIdBitmap bitmap;
+    ASSERT(bitmap.add(RecordId(5)));
+    ASSERT(bitmap.add(RecordId(1LL << 40)));
+    ASSERT_FALSE(bitmap.add(RecordId(5)));
+    ASSERT_EQUALS(2U, bitmap.size());
+
+    ASSERT(bitmap.contains(RecordId(5)));
+    ASSERT(bitmap.contains(RecordId(1LL << 40)));
+    ASSERT_FALSE(bitmap.contains(RecordId(6)));
+    ASSERT_FALSE(bitmap.contains(RecordId((1LL << 40) + 5)));
+
+    ASSERT(bitmap.remove(RecordId(5)));
+    ASSERT_FALSE(bitmap.remove(RecordId(5)));
+    ASSERT_FALSE(bitmap.contains(RecordId(5)));
+    ASSERT_EQUALS(1U, bitmap.size());
+
+    ASSERT(bitmap.remove(RecordId(1LL << 40)));
+    ASSERT(bitmap.empty());
+    ASSERT_EQUALS(0U, bitmap.getMemUsage());
+}
+
+TEST(RecordIdBitmapTest, LowerBoundIteratesInOrder) {
+    RecordIdBitmap bitmap;
+    const long long ids[] = {70000, 3, 1LL << 33, 65535, 65536, 17};
+    for (long long id : ids) {
+        ASSERT(bitmap.add(RecordId(id)));
+    }
+
+    const long long expected[] = {3, 17, 65535, 65536, 70000, 1LL << 33};
+    RecordId current = RecordId::min();
+    for (long long id : expected) {
+        RecordId out;
+        ASSERT(bitmap.lowerBound(current, &out));
+        ASSERT_EQUALS(RecordId(id), out);
+        current = RecordId(out.repr() + 1);
+    }
+
+    RecordId out;
+    ASSERT_FALSE(bitmap.lowerBound(current, &out));
+
+    // Bounds landing exactly on a member return that member.
+    ASSERT(bitmap.lowerBound(RecordId(65536), &out));
+    ASSERT_EQUALS(RecordId(65536), out);
+}
+
+TEST(RecordIdBitmapTest, DenseChunkUsesBitmapContainer) {
+    RecordIdBitmap bitmap;
+    const long long numIds = 3 * RecordIdBitmap::kMaxArrayContainerSize;
+    for (long long id = 1; id <= numIds; ++id) {
+        ASSERT(bitmap.add(RecordId(id)));
+    }
+    ASSERT_EQUALS(static_cast<size_t>(numIds), bitmap.size());
+
+    // All of the ids share one chunk, which must have been converted to a bitmap: well under a
+    // byte per id.
+    ASSERT_LESS_THAN(bitmap.getMemUsage(), static_cast<size_t>(numIds) / 2);
+
+    RecordId out;
+    ASSERT(bitmap.lowerBound(RecordId(1000), &out));
+    ASSERT_EQUALS(RecordId(1000), out);
+    ASSERT_FALSE(bitmap.lowerBound(RecordId(numIds + 1), &out));
+
+    // Removing most members converts the chunk back to an array, preserving the survivors.
+    for (long long id = 1; id <= numIds; ++id) {
+        if (id % 100 != 0) {
+            ASSERT(bitmap.remove(RecordId(id)));
+        }
+    }
+    ASSERT_EQUALS(static_cast<size_t>(numIds / 100), bitmap.size());
+    for (long long id = 1; id <= numIds; ++id) {
+        ASSERT_EQUALS(id % 100 == 0, bitmap.contains(RecordId(id)));
+    }
+    ASSERT(bitmap.lowerBound(RecordId(101), &out));
+    ASSERT_EQUALS(RecordId(200), out);
+}
+
+TEST(RecordIdBitmapTest, SwapAndClear) {
+    RecordIdBitmap a;
+    RecordIdBitmap b;
+    a.add(RecordId(1));
+    a.add(RecordId(2));
+    b.add(RecordId(3));
+
+    a.swap(b);
+    ASSERT_EQUALS(1U, a.size());
+    ASSERT(a.contains(RecordId(3)));
+    ASSERT_EQUALS(2U, b.size());
+    ASSERT(b.contains(RecordId(1)));
+
+    b.clear();
+    ASSERT(b.empty());
+    ASSERT_FALSE(b.contains(RecordId(1)));
+    ASSERT_EQUALS(0U, b.getMemUsage());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -141,6 +141,39 @@ private:
 };
 
 
+/**
+ * Estimates the number of distinct values with a HyperLogLog sketch. Unlike $addToSet, memory use
+ * is fixed regardless of cardinality, and partial results from shards merge without loss of
+ * accuracy. The standard error of the estimate is about 1.6%.
+ */
+class AccumulatorApproxCountDistinct final : public Accumulator {
+public:
+    AccumulatorApproxCountDistinct();
+
+    void processInternal(const Value& input, bool merging) final;
+    Value getValue(bool toBeMerged) const final;
+    const char* getOpName() const final;
+    void reset() final;
+
+    static boost::intrusive_ptr<Accumulator> create();
+
+    bool isAssociative() const final {
+        return true;
+    }
+
+    bool isCommutative() const final {
+        return true;
+    }
+
+private:
+    // Number of hash bits used to select a register.
+    static const int kPrecision = 12;
+    static const size_t kNumRegisters = size_t(1) << kPrecision;
+
+    std::vector<uint8_t> _registers;
+};
+
+
 class AccumulatorFirst final : public Accumulator {
 public:
     AccumulatorFirst();
@@ -0,0 +1,142 @@
+/**
+ * Copyright (C) 2016 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <cmath>
+
+#include "mongo/db/pipeline/accumulator.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/value.h"
+#include "mongo/platform/bits.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+REGISTER_ACCUMULATOR(approxCountDistinct, AccumulatorApproxCountDistinct::create);
+
+namespace {
+
+// Finalizer from MurmurHash3. Value::hash_combine() is built on boost::hash_combine, whose output
+// is not uniformly distributed enough for HyperLogLog, so we scramble the bits first.
+uint64_t mix64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+}  // namespace
+
+const int AccumulatorApproxCountDistinct::kPrecision;
+const size_t AccumulatorApproxCountDistinct::kNumRegisters;
+
+const char* AccumulatorApproxCountDistinct::getOpName() const {
+    return "$approxCountDistinct";
+}
+
+void AccumulatorApproxCountDistinct::processInternal(const Value& input, bool merging) {
+    if (!merging) {
+        if (input.missing())
+            return;
+
+        // Values which compare equal hash equally, so this counts distinct values the same way
+        // $addToSet does.
+        size_t seed = 0;
+        input.hash_combine(seed);
+        const uint64_t hash = mix64(seed);
+
+        // The top kPrecision bits pick the register, the remaining bits give the rank. Setting
+        // the lowest bit bounds the rank so it always fits the register.
+        const size_t index = hash >> (64 - kPrecision);
+        const uint64_t remaining = (hash << kPrecision) | 1;
+        const uint8_t rank = countLeadingZeros64(remaining) + 1;
+
+        if (rank > _registers[index])
+            _registers[index] = rank;
+    } else {
+        // This is what getValue(true) produced below.
+        verify(input.getType() == BinData);
+        const BSONBinData registers = input.getBinData();
+        uassert(34432,
+                str::stream() << "$approxCountDistinct cannot merge a partial result of "
+                              << registers.length << " bytes, expected " << kNumRegisters,
+                size_t(registers.length) == kNumRegisters);
+
+        const uint8_t* ranks = static_cast<const uint8_t*>(registers.data);
+        for (size_t i = 0; i < kNumRegisters; i++) {
+            const uint8_t rank = ranks[i];
+            if (rank > _registers[i])
+                _registers[i] = rank;
+        }
+    }
+}
+
+Value AccumulatorApproxCountDistinct::getValue(bool toBeMerged) const {
+    if (toBeMerged) {
+        return Value(BSONBinData(_registers.data(), kNumRegisters, BinDataGeneral));
+    }
+
+    // This is the estimator from Flajolet et al., "HyperLogLog: the analysis of a near-optimal
+    // cardinality estimation algorithm", with linear counting for small cardinalities. The large
+    // range correction is unnecessary with 64-bit hashes.
+    const double m = kNumRegisters;
+    double sum = 0;
+    size_t zeroRegisters = 0;
+    for (size_t i = 0; i < kNumRegisters; i++) {
+        sum += std::ldexp(1.0, -_registers[i]);
+        if (_registers[i] == 0)
+            zeroRegisters++;
+    }
+
+    const double alpha = 0.7213 / (1 + 1.079 / m);
+    double estimate = alpha * m * m / sum;
+    if (estimate <= 2.5 * m && zeroRegisters != 0) {
+        estimate = m * std::log(m / zeroRegisters);
+    }
+
+    return Value(static_cast<long long>(std::llround(estimate)));
+}
+
+AccumulatorApproxCountDistinct::AccumulatorApproxCountDistinct() : _registers(kNumRegisters, 0) {
+    // This is a fixed size Accumulator so we never need to update this
+    _memUsageBytes = sizeof(*this) + kNumRegisters;
+}
+
+void AccumulatorApproxCountDistinct::reset() {
+    std::fill(_registers.begin(), _registers.end(), 0);
+}
+
+intrusive_ptr<Accumulator> AccumulatorApproxCountDistinct::create() {
+    return new AccumulatorApproxCountDistinct();
+}
+}
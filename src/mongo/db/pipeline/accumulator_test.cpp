@@ -277,4 +277,44 @@ TEST(Accumulators, Sum) {
          {{Value(9), Value()}, Value(9)}});
 }
 
+TEST(Accumulators, ApproxCountDistinct) {
+    assertExpectedResults(
+        "$approxCountDistinct",
+        {// No documents evaluated.
+         {{}, Value(0LL)},
+         // A single value.
+         {{Value(5)}, Value(1LL)},
+         // Numerically equal values are counted once.
+         {{Value(5), Value(5LL), Value(5.0)}, Value(1LL)},
+         // Duplicate strings are counted once.
+         {{Value("a"), Value("a")}, Value(1LL)},
+         // Missing values are ignored.
+         {{Value(), Value(BSONNULL)}, Value(1LL)}});
+}
+
+TEST(Accumulators, ApproxCountDistinctIsAccurateAndMergesExactly) {
+    auto factory = Accumulator::getFactory("$approxCountDistinct");
+    const long long numDistinct = 100000;
+
+    intrusive_ptr<Accumulator> single = factory();
+    intrusive_ptr<Accumulator> merger = factory();
+    std::vector<intrusive_ptr<Accumulator>> shards{factory(), factory(), factory()};
+    for (long long i = 0; i < numDistinct; i++) {
+        // Each value is seen twice, on different shards.
+        single->process(Value(i), false);
+        single->process(Value(i), false);
+        shards[i % shards.size()]->process(Value(i), false);
+        shards[(i + 1) % shards.size()]->process(Value(i), false);
+    }
+    for (auto&& shard : shards) {
+        merger->process(shard->getValue(true), true);
+    }
+
+    const long long estimate = single->getValue(false).getLong();
+    ASSERT_LT(std::abs(estimate - numDistinct), numDistinct / 20);
+
+    // Merging sketches is lossless, so the sharded estimate matches the unsharded one.
+    ASSERT_EQUALS(estimate, merger->getValue(false).getLong());
+}
+
 }  // namespace AccumulatorTests
@@ -96,7 +96,7 @@ BSONObj DepsTracker::toProjection() const {
 boost::optional<ParsedDeps> DepsTracker::toParsedDeps() const {
     MutableDocument md;
 
-    if (needWholeDocument || needTextScore) {
+    if (needWholeDocument) {
         // can't use ParsedDeps in this case
         return boost::none;
     }
@@ -114,7 +114,7 @@ boost::optional<ParsedDeps> DepsTracker::toParsedDeps() const {
         md.setNestedField(*it, Value(true));
     }
 
-    return ParsedDeps(md.freeze());
+    return ParsedDeps(md.freeze(), needTextScore);
 }
 
 namespace {
@@ -141,42 +141,71 @@ Value arrayHelper(const BSONObj& bson, const Document& neededFields) {
     return Value(std::move(values));
 }
 
+// Adds 'bsonElement' to 'md' if it is needed according to 'neededFields'. Returns true if the
+// field was one of the needed fields, whether or not anything was added.
+bool addFieldIfNeeded(MutableDocument* md,
+                      const BSONElement& bsonElement,
+                      const Document& neededFields) {
+    StringData fieldName = bsonElement.fieldNameStringData();
+    Value isNeeded = neededFields[fieldName];
+
+    if (isNeeded.missing())
+        return false;
+
+    if (isNeeded.getType() == Bool) {
+        md->addField(fieldName, Value(bsonElement));
+        return true;
+    }
+
+    dassert(isNeeded.getType() == Object);
+
+    if (bsonElement.type() == Object) {
+        Document sub = documentHelper(bsonElement.embeddedObject(), isNeeded.getDocument());
+        md->addField(fieldName, Value(sub));
+    }
+
+    if (bsonElement.type() == Array) {
+        md->addField(fieldName, arrayHelper(bsonElement.embeddedObject(), isNeeded.getDocument()));
+    }
+
+    return true;
+}
+
 // Handles object-typed values including the top-level for ParsedDeps::extractFields
 Document documentHelper(const BSONObj& bson, const Document& neededFields) {
     MutableDocument md(neededFields.size());
 
     BSONObjIterator it(bson);
     while (it.more()) {
-        BSONElement bsonElement(it.next());
-        StringData fieldName = bsonElement.fieldNameStringData();
-        Value isNeeded = neededFields[fieldName];
+        addFieldIfNeeded(&md, it.next(), neededFields);
+    }
 
-        if (isNeeded.missing())
-            continue;
+    return md.freeze();
+}
+}  // namespace
 
-        if (isNeeded.getType() == Bool) {
-            md.addField(fieldName, Value(bsonElement));
-            continue;
-        }
+Document ParsedDeps::extractFields(const BSONObj& input) const {
+    MutableDocument md(_nFields);
 
-        dassert(isNeeded.getType() == Object);
+    // Each top-level field appears at most once in well-formed BSON, so once we have seen all of
+    // the needed fields there is no reason to keep walking the rest of the document.
+    size_t remaining = _nFields + (_needTextScore ? 1 : 0);
 
-        if (bsonElement.type() == Object) {
-            Document sub = documentHelper(bsonElement.embeddedObject(), isNeeded.getDocument());
-            md.addField(fieldName, Value(sub));
+    BSONObjIterator it(input);
+    while (remaining > 0 && it.more()) {
+        BSONElement bsonElement(it.next());
+
+        if (_needTextScore && bsonElement.fieldNameStringData() == Document::metaFieldTextScore) {
+            md.setTextScore(bsonElement.Double());
+            --remaining;
+            continue;
         }
 
-        if (bsonElement.type() == Array) {
-            md.addField(fieldName,
-                        arrayHelper(bsonElement.embeddedObject(), isNeeded.getDocument()));
+        if (addFieldIfNeeded(&md, bsonElement, _fields)) {
+            --remaining;
         }
     }
 
     return md.freeze();
 }
-}  // namespace
-
-Document ParsedDeps::extractFields(const BSONObj& input) const {
-    return documentHelper(input, _fields);
-}
 }
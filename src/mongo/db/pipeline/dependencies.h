@@ -61,12 +61,20 @@ struct DepsTracker {
  */
 class ParsedDeps {
 public:
+    /**
+     * Builds a Document containing only the needed fields of 'input' in a single pass over the
+     * BSON. Iteration stops as soon as every needed top-level field (and the text score, if
+     * requested) has been seen, so trailing fields of wide documents are never visited.
+     */
     Document extractFields(const BSONObj& input) const;
 
 private:
     friend struct DepsTracker;  // so it can call constructor
-    explicit ParsedDeps(const Document& fields) : _fields(fields) {}
+    ParsedDeps(const Document& fields, bool needTextScore)
+        : _fields(fields), _nFields(fields.size()), _needTextScore(needTextScore) {}
 
     Document _fields;
+    size_t _nFields;  // Number of top-level fields in '_fields'.
+    bool _needTextScore;
 };
 }
@@ -43,6 +43,7 @@
 #include "mongo/client/connpool.h"
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/collection_index_usage_tracker.h"
+#include "mongo/db/collection_query_shape_stats_tracker.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/matcher.h"
 #include "mongo/db/pipeline/accumulator.h"
@@ -296,6 +297,9 @@ public:
         virtual CollectionIndexUsageMap getIndexStats(OperationContext* opCtx,
                                                       const NamespaceString& ns) = 0;
 
+        virtual std::vector<CollectionQueryShapeStatsTracker::ShapeStats> getQueryShapeStats(
+            OperationContext* opCtx, const NamespaceString& ns) = 0;
+
         // Add new methods as needed.
     };
 
@@ -562,6 +566,35 @@ private:
     std::string _processName;
 };
 
+/**
+ * Provides a document source interface to retrieve per-query-shape execution statistics for a
+ * given namespace. Each document returned represents a single query shape, operation type and
+ * mongod instance.
+ */
+class DocumentSourceQueryShapeStats final : public DocumentSource,
+                                            public DocumentSourceNeedsMongod {
+public:
+    // virtuals from DocumentSource
+    boost::optional<Document> getNext() final;
+    const char* getSourceName() const final;
+    Value serialize(bool explain = false) const final;
+
+    virtual bool isValidInitialSource() const final {
+        return true;
+    }
+
+    static boost::intrusive_ptr<DocumentSource> createFromBson(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& pExpCtx);
+
+private:
+    DocumentSourceQueryShapeStats(const boost::intrusive_ptr<ExpressionContext>& pExpCtx);
+
+    bool _populated = false;
+    std::vector<CollectionQueryShapeStatsTracker::ShapeStats> _shapeStats;
+    std::vector<CollectionQueryShapeStatsTracker::ShapeStats>::const_iterator _shapeStatsIter;
+    std::string _processName;
+};
+
 class DocumentSourceMatch final : public DocumentSource {
 public:
     // virtuals from DocumentSource
@@ -770,7 +803,10 @@ public:
     const char* getSourceName() const final;
     /**
      * Attempt to move a subsequent $skip or $limit stage before the $project, thus reducing the
-     * number of documents that pass through this stage.
+     * number of documents that pass through this stage. A subsequent $sort is also moved before
+     * the $project when every field it sorts on passes through the $project unchanged and the
+     * $project is the first stage or follows the initial $match, so that the $sort can later be
+     * absorbed by the query layer.
      */
     Pipeline::SourceContainer::iterator optimizeAt(Pipeline::SourceContainer::iterator itr,
                                                    Pipeline::SourceContainer* container) final;
@@ -801,6 +837,12 @@ private:
     DocumentSourceProject(const boost::intrusive_ptr<ExpressionContext>& pExpCtx,
                           const boost::intrusive_ptr<ExpressionObject>& exprObj);
 
+    /**
+     * Returns true if every field 'sort' depends on has the same value before and after this
+     * $project, so that the $sort may be performed before it instead.
+     */
+    bool sortKeyIsPreserved(const DocumentSourceSort& sort) const;
+
     // configuration state
     std::unique_ptr<Variables> _variables;
     boost::intrusive_ptr<ExpressionObject> pEO;
@@ -90,15 +90,41 @@ Pipeline::SourceContainer::iterator DocumentSourceProject::optimizeAt(
     auto nextSkip = dynamic_cast<DocumentSourceSkip*>((*std::next(itr)).get());
     auto nextLimit = dynamic_cast<DocumentSourceLimit*>((*std::next(itr)).get());
 
-    if (nextSkip || nextLimit) {
-        // Swap the $limit/$skip before ourselves, thus reducing the number of documents that
-        // pass through the $project.
+    // A $sort is only moved ahead of us if that lets the query system provide the sort order,
+    // i.e. if we are the first stage or directly follow the initial $match. Anywhere else the
+    // in-memory $sort would buffer the unprojected documents instead.
+    auto nextSort = dynamic_cast<DocumentSourceSort*>((*std::next(itr)).get());
+    const bool sortCanReachQuery = itr == container->begin() ||
+        (std::prev(itr) == container->begin() &&
+         dynamic_cast<DocumentSourceMatch*>(container->begin()->get()));
+
+    if (nextSkip || nextLimit || (nextSort && sortCanReachQuery && sortKeyIsPreserved(*nextSort))) {
+        // Swap the $limit/$skip/$sort before ourselves, thus reducing the number of documents
+        // that pass through the $project. Moving a $sort forward also gives the query system a
+        // chance to provide the sort order from an index.
         std::swap(*itr, *std::next(itr));
         return itr == container->begin() ? itr : std::prev(itr);
     }
     return std::next(itr);
 }
 
+bool DocumentSourceProject::sortKeyIsPreserved(const DocumentSourceSort& sort) const {
+    DepsTracker sortDeps;
+    sort.getDependencies(&sortDeps);
+
+    // Metadata such as the text score is copied through unchanged, so only the fields matter.
+    if (sortDeps.needWholeDocument) {
+        return false;
+    }
+
+    for (auto&& field : sortDeps.fields) {
+        if (!pEO->isPathPreserved(FieldPath(field))) {
+            return false;
+        }
+    }
+    return true;
+}
+
 Value DocumentSourceProject::serialize(bool explain) const {
     return Value(DOC(getSourceName() << pEO->serialize(explain)));
 }
@@ -156,6 +156,42 @@ public:
         }
     }
 };
+
+class ExtractFields {
+public:
+    void run() {
+        {
+            const char* array[] = {"a", "c.d"};  // only needed fields are extracted
+            DepsTracker deps;
+            deps.fields = arrayToSet(array);
+            auto parsedDeps = deps.toParsedDeps();
+            ASSERT(parsedDeps);
+            Document doc = parsedDeps->extractFields(
+                BSON("a" << 1 << "b" << 2 << "c" << BSON("d" << 3 << "e" << 4) << "f" << 5));
+            ASSERT_EQUALS(doc, DOC("a" << 1 << "c" << DOC("d" << 3)));
+        }
+        {
+            const char* array[] = {"a"};  // needTextScore can still use ParsedDeps
+            DepsTracker deps;
+            deps.fields = arrayToSet(array);
+            deps.needTextScore = true;
+            auto parsedDeps = deps.toParsedDeps();
+            ASSERT(parsedDeps);
+            Document doc = parsedDeps->extractFields(
+                BSON("a" << 1 << "b" << 2 << Document::metaFieldTextScore << 1.5));
+            ASSERT_EQUALS(doc, DOC("a" << 1));
+            ASSERT(doc.hasTextScore());
+            ASSERT_EQUALS(doc.getTextScore(), 1.5);
+        }
+        {
+            const char* array[] = {"a"};  // needWholeDocument requires full conversion
+            DepsTracker deps;
+            deps.fields = arrayToSet(array);
+            deps.needWholeDocument = true;
+            ASSERT(!deps.toParsedDeps());
+        }
+    }
+};
 }
 
 namespace Mock {
@@ -2864,6 +2900,7 @@ public:
     All() : Suite("documentsource") {}
     void setupTests() {
         add<DocumentSourceClass::Deps>();
+        add<DocumentSourceClass::ExtractFields>();
 
         add<DocumentSourceLimit::DisposeSource>();
         add<DocumentSourceLimit::CombineLimit>();
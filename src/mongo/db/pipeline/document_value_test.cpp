@@ -537,6 +537,22 @@ TEST(MetaFields, BadSerialization) {
 }
 }  // namespace MetaFields
 
+namespace ApproximateSize {
+using mongo::Value;
+TEST(ApproximateSize, ArrayIncludesUnusedCapacity) {
+    std::vector<Value> values;
+    values.reserve(16);
+    values.push_back(Value(1));
+    const size_t expected = 2 * sizeof(Value) + sizeof(RCVector) + 15 * sizeof(Value);
+    ASSERT_EQ(expected, Value(std::move(values)).getApproximateSize());
+}
+
+TEST(ApproximateSize, LongStringIncludesTerminatingNul) {
+    const std::string str(100, 'x');
+    ASSERT_EQ(sizeof(Value) + sizeof(RCString) + str.size() + 1, Value(str).getApproximateSize());
+}
+}  // namespace ApproximateSize
+
 namespace Value {
 
 using mongo::Value;
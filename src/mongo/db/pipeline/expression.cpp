@@ -1432,6 +1432,29 @@ void ExpressionObject::includePath(const string& theFieldPath) {
     addField(theFieldPath, NULL);
 }
 
+bool ExpressionObject::isPathPreserved(const FieldPath& path) const {
+    const string& fieldName = path.getFieldName(0);
+    FieldMap::const_iterator it = _expressions.find(fieldName);
+
+    if (it == _expressions.end()) {
+        // _id from the root doc is always included unless explicitly excluded.
+        return _atRoot && !_excludeId && fieldName == "_id";
+    }
+
+    if (!it->second) {
+        // Inclusion of the whole field.
+        return true;
+    }
+
+    ExpressionObject* exprObj = dynamic_cast<ExpressionObject*>(it->second.get());
+    if (!exprObj || path.getPathLength() == 1) {
+        // The field is computed, or only some of its subfields are kept.
+        return false;
+    }
+
+    return exprObj->isPathPreserved(path.tail());
+}
+
 Value ExpressionObject::serialize(bool explain) const {
     MutableDocument valBuilder;
     if (_excludeId)
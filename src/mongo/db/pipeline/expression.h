@@ -1088,6 +1088,13 @@ public:
         _excludeId = b;
     }
 
+    /**
+     * Returns true if the value at 'path' in the output of addToDocument() is guaranteed to be
+     * identical to the value at 'path' in the input document, i.e. the path or one of its
+     * prefixes is a plain inclusion (or the implicitly included _id at the root).
+     */
+    bool isPathPreserved(const FieldPath& path) const;
+
 private:
     explicit ExpressionObject(bool atRoot);
 
@@ -216,6 +216,9 @@ Status Pipeline::checkAuthForCommand(ClientBasic* client,
         Privilege::addPrivilegeToPrivilegeVector(
             &privileges,
             Privilege(ResourcePattern::forAnyNormalResource(), ActionType::indexStats));
+    } else if (cmdObj.getFieldDotted("pipeline.0.$queryShapeStats")) {
+        Privilege::addPrivilegeToPrivilegeVector(
+            &privileges, Privilege(inputResource, ActionType::planCacheRead));
     } else {
         // If no source requiring an alternative permission scheme is specified then default to
         // requiring find() privileges on the given namespace.
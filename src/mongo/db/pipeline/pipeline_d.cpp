@@ -114,6 +114,19 @@ public:
         return collection->infoCache()->getIndexUsageStats();
     }
 
+    std::vector<CollectionQueryShapeStatsTracker::ShapeStats> getQueryShapeStats(
+        OperationContext* opCtx, const NamespaceString& ns) final {
+        AutoGetCollectionForRead autoColl(opCtx, ns);
+
+        Collection* collection = autoColl.getCollection();
+        if (!collection) {
+            LOG(2) << "Collection not found on query shape stats retrieval: " << ns.ns();
+            return {};
+        }
+
+        return collection->infoCache()->getQueryShapeStats();
+    }
+
 private:
     intrusive_ptr<ExpressionContext> _ctx;
     DBDirectClient _client;
@@ -204,6 +204,64 @@ class MoveMatchBeforeSort : public Base {
     }
 };
 
+class MoveSortBeforeProjectThatPreservesSortKey : public Base {
+    string inputPipeJson() override {
+        return "[{$project: {a: 1, b: {c: 1}, d: {$add: ['$x', 1]}}}"
+               ",{$sort: {'b.c': 1, a: -1, _id: 1}}"
+               ",{$limit: 5}"
+               "]";
+    }
+
+    string outputPipeJson() override {
+        return "[{$sort: {sortKey: {'b.c': 1, a: -1, _id: 1}, limit: 5}}"
+               ",{$project: {a: true, b: {c: true}, d: {$add: ['$x', {$const: 1}]}}}"
+               "]";
+    }
+};
+
+class DoNotMoveSortBeforeProjectThatComputesSortKey : public Base {
+    string inputPipeJson() override {
+        return "[{$project: {a: '$b'}}, {$sort: {a: 1}}]";
+    }
+
+    string outputPipeJson() override {
+        return "[{$project: {a: '$b'}}, {$sort: {sortKey: {a: 1}}}]";
+    }
+};
+
+class DoNotMoveSortBeforeProjectThatExcludesId : public Base {
+    string inputPipeJson() override {
+        return "[{$project: {_id: 0, a: 1}}, {$sort: {_id: 1}}]";
+    }
+
+    string outputPipeJson() override {
+        return "[{$project: {_id: false, a: true}}, {$sort: {sortKey: {_id: 1}}}]";
+    }
+};
+
+class MoveSortBeforeProjectAfterInitialMatch : public Base {
+    string inputPipeJson() override {
+        return "[{$match: {a: 1}}, {$project: {a: 1}}, {$sort: {a: 1}}]";
+    }
+
+    string outputPipeJson() override {
+        return "[{$match: {a: 1}}, {$sort: {sortKey: {a: 1}}}, {$project: {a: true}}]";
+    }
+};
+
+class DoNotMoveSortBeforeProjectMidPipeline : public Base {
+    string inputPipeJson() override {
+        return "[{$group: {_id: '$a', b: {$push: '$b'}}}, {$project: {b: 1}}, {$sort: {_id: 1}}]";
+    }
+
+    string outputPipeJson() override {
+        return "[{$group: {_id: '$a', b: {$push: '$b'}}}"
+               ",{$project: {b: true}}"
+               ",{$sort: {sortKey: {_id: 1}}}"
+               "]";
+    }
+};
+
 class LookupShouldCoalesceWithUnwindOnAs : public Base {
     string inputPipeJson() {
         return "[{$lookup: {from : 'coll2', as : 'same', localField: 'left', foreignField: "
@@ -668,6 +726,11 @@ public:
         add<Optimizations::Local::RemoveEmptyMatch>();
         add<Optimizations::Local::RemoveMultipleEmptyMatches>();
         add<Optimizations::Local::MoveMatchBeforeSort>();
+        add<Optimizations::Local::MoveSortBeforeProjectThatPreservesSortKey>();
+        add<Optimizations::Local::DoNotMoveSortBeforeProjectThatComputesSortKey>();
+        add<Optimizations::Local::DoNotMoveSortBeforeProjectThatExcludesId>();
+        add<Optimizations::Local::MoveSortBeforeProjectAfterInitialMatch>();
+        add<Optimizations::Local::DoNotMoveSortBeforeProjectMidPipeline>();
         add<Optimizations::Local::DoNotRemoveNonEmptyMatch>();
         add<Optimizations::Local::LookupShouldCoalesceWithUnwindOnAs>();
         add<Optimizations::Local::LookupShouldCoalesceWithUnwindOnAsWithPreserveEmpty>();
@@ -994,17 +994,19 @@ size_t Value::getApproximateSize() const {
         case String:
             return sizeof(Value) + (_storage.shortStr
                                         ? 0  // string stored inline, so no extra mem usage
-                                        : sizeof(RCString) + _storage.getString().size());
+                                        : sizeof(RCString) + _storage.getString().size() + 1);
 
         case Object:
             return sizeof(Value) + getDocument().getApproximateSize();
 
         case Array: {
+            const std::vector<Value>& array = getArray();
             size_t size = sizeof(Value);
             size += sizeof(RCVector);
-            const size_t n = getArray().size();
-            for (size_t i = 0; i < n; ++i) {
-                size += getArray()[i].getApproximateSize();
+            // Account for the unused tail of the vector's buffer; used slots are counted below.
+            size += (array.capacity() - array.size()) * sizeof(Value);
+            for (size_t i = 0; i < array.size(); ++i) {
+                size += array[i].getApproximateSize();
             }
             return size;
         }
@@ -119,7 +119,7 @@ MultiPlanStage* getMultiPlanStage(PlanStage* root) {
  * (in which case this gets called from Explain::getSummaryStats()).
  */
 size_t getKeysExamined(StageType type, const SpecificStats* specific) {
-    if (STAGE_IXSCAN == type) {
+    if (STAGE_IXSCAN == type || STAGE_MERGE_IXSCAN == type) {
         const IndexScanStats* spec = static_cast<const IndexScanStats*>(specific);
         return spec->keysExamined;
     } else if (STAGE_IDHACK == type) {
@@ -158,6 +158,9 @@ size_t getDocsExamined(StageType type, const SpecificStats* specific) {
     } else if (STAGE_TEXT_OR == type) {
         const TextOrStats* spec = static_cast<const TextOrStats*>(specific);
         return spec->fetches;
+    } else if (STAGE_AND_BITMAP == type) {
+        const AndBitmapStats* spec = static_cast<const AndBitmapStats*>(specific);
+        return spec->docsFetched;
     }
 
     return 0;
@@ -185,7 +188,7 @@ void addStageSummaryStr(const PlanStage* stage, mongoutils::str::stream& ss) {
     } else if (STAGE_GEO_NEAR_2DSPHERE == stage->stageType()) {
         const NearStats* spec = static_cast<const NearStats*>(specific);
         ss << " " << spec->keyPattern;
-    } else if (STAGE_IXSCAN == stage->stageType()) {
+    } else if (STAGE_IXSCAN == stage->stageType() || STAGE_MERGE_IXSCAN == stage->stageType()) {
         const IndexScanStats* spec = static_cast<const IndexScanStats*>(specific);
         ss << " " << spec->keyPattern;
     } else if (STAGE_TEXT == stage->stageType()) {
@@ -238,7 +241,20 @@ void Explain::statsToBSON(const PlanStageStats& stats,
     }
 
     // Stage-specific stats
-    if (STAGE_AND_HASH == stats.stageType) {
+    if (STAGE_AND_BITMAP == stats.stageType) {
+        AndBitmapStats* spec = static_cast<AndBitmapStats*>(stats.specific.get());
+
+        if (verbosity >= ExplainCommon::EXEC_STATS) {
+            bob->appendNumber("memUsage", spec->memUsage);
+            bob->appendNumber("memLimit", spec->memLimit);
+
+            bob->appendNumber("docsFetched", spec->docsFetched);
+            for (size_t i = 0; i < spec->intersectionAfterChild.size(); ++i) {
+                bob->appendNumber(string(stream() << "intersectionAfterChild_" << i),
+                                  spec->intersectionAfterChild[i]);
+            }
+        }
+    } else if (STAGE_AND_HASH == stats.stageType) {
         AndHashStats* spec = static_cast<AndHashStats*>(stats.specific.get());
 
         if (verbosity >= ExplainCommon::EXEC_STATS) {
@@ -261,6 +277,12 @@ void Explain::statsToBSON(const PlanStageStats& stats,
                 bob->appendNumber(string(stream() << "failedAnd_" << i), spec->failedAnd[i]);
             }
         }
+    } else if (STAGE_CACHED_PLAN == stats.stageType) {
+        CachedPlanStats* spec = static_cast<CachedPlanStats*>(stats.specific.get());
+
+        if (verbosity >= ExplainCommon::EXEC_STATS) {
+            bob->appendBool("replannedMidQuery", spec->replannedMidQuery);
+        }
     } else if (STAGE_COLLSCAN == stats.stageType) {
         CollectionScanStats* spec = static_cast<CollectionScanStats*>(stats.specific.get());
         bob->append("direction", spec->direction > 0 ? "forward" : "backward");
@@ -360,7 +382,7 @@ void Explain::statsToBSON(const PlanStageStats& stats,
             bob->appendNumber("keysExamined", spec->keysExamined);
             bob->appendNumber("docsExamined", spec->docsExamined);
         }
-    } else if (STAGE_IXSCAN == stats.stageType) {
+    } else if (STAGE_IXSCAN == stats.stageType || STAGE_MERGE_IXSCAN == stats.stageType) {
         IndexScanStats* spec = static_cast<IndexScanStats*>(stats.specific.get());
 
         bob->append("keyPattern", spec->keyPattern);
@@ -776,10 +798,10 @@ void Explain::getSummaryStats(const PlanExecutor& exec, PlanSummaryStats* statsO
             statsOut->hasSortStage = true;
         }
 
-        if (STAGE_IXSCAN == stages[i]->stageType()) {
-            const IndexScan* ixscan = static_cast<const IndexScan*>(stages[i]);
+        if (STAGE_IXSCAN == stages[i]->stageType() ||
+            STAGE_MERGE_IXSCAN == stages[i]->stageType()) {
             const IndexScanStats* ixscanStats =
-                static_cast<const IndexScanStats*>(ixscan->getSpecificStats());
+                static_cast<const IndexScanStats*>(stages[i]->getSpecificStats());
             statsOut->indexesUsed.insert(ixscanStats->indexName);
         } else if (STAGE_COUNT_SCAN == stages[i]->stageType()) {
             const CountScan* countScan = static_cast<const CountScan*>(stages[i]);
@@ -812,6 +834,7 @@ void Explain::getSummaryStats(const PlanExecutor& exec, PlanSummaryStats* statsO
             const CachedPlanStats* cachedStats =
                 static_cast<const CachedPlanStats*>(cachedPlan->getSpecificStats());
             statsOut->replanned = cachedStats->replanned;
+            statsOut->fromPlanCache = !cachedStats->replanned;
         } else if (STAGE_MULTI_PLAN == stages[i]->stageType()) {
             statsOut->fromMultiPlanner = true;
         }
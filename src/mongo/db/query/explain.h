@@ -73,6 +73,9 @@ struct PlanSummaryStats {
 
     // Was a replan triggered during the execution of this query?
     bool replanned = false;
+
+    // Did this plan come from the plan cache without being replanned?
+    bool fromPlanCache = false;
 };
 
 /**
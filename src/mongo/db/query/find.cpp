@@ -162,6 +162,11 @@ void endQueryOp(OperationContext* txn,
 
     if (collection) {
         collection->infoCache()->notifyOfQuery(txn, summaryStats.indexesUsed);
+        collection->infoCache()->notifyOfQueryShapeExecution(
+            CollectionQueryShapeStatsTracker::OpType::kFind,
+            exec.getCanonicalQuery(),
+            summaryStats,
+            curop->elapsedMicros());
     }
 
     const logger::LogComponent commandLogComponent = logger::LogComponent::kCommand;
@@ -191,6 +196,30 @@ void endQueryOp(OperationContext* txn,
     }
 }
 
+void endGetMoreBatch(OperationContext* txn,
+                     Collection* collection,
+                     const PlanExecutor& exec,
+                     const PlanSummaryStats& preBatchStats) {
+    if (!collection) {
+        return;
+    }
+
+    // The executor's summary stats are cumulative over the life of the cursor, so subtract the
+    // stats from before this batch.
+    PlanSummaryStats batchStats;
+    Explain::getSummaryStats(exec, &batchStats);
+    batchStats.totalKeysExamined -= preBatchStats.totalKeysExamined;
+    batchStats.totalDocsExamined -= preBatchStats.totalDocsExamined;
+    batchStats.nReturned -= preBatchStats.nReturned;
+    batchStats.fromPlanCache = false;
+
+    collection->infoCache()->notifyOfQueryShapeExecution(
+        CollectionQueryShapeStatsTracker::OpType::kGetMore,
+        exec.getCanonicalQuery(),
+        batchStats,
+        CurOp::get(txn)->elapsedMicros());
+}
+
 namespace {
 
 /**
@@ -393,6 +422,9 @@ QueryResult::View getMore(OperationContext* txn,
         exec->restoreState();
         PlanExecutor::ExecState state;
 
+        PlanSummaryStats preBatchStats;
+        Explain::getSummaryStats(*exec, &preBatchStats);
+
         generateBatch(ntoreturn, cc, &bb, &numResults, &slaveReadTill, &state);
 
         // If this is an await data cursor, and we hit EOF without generating any results, then
@@ -420,6 +452,11 @@ QueryResult::View getMore(OperationContext* txn,
             generateBatch(ntoreturn, cc, &bb, &numResults, &slaveReadTill, &state);
         }
 
+        // Agg cursors do not hold the collection lock here, and are not recorded.
+        if (ctx) {
+            endGetMoreBatch(txn, ctx->getCollection(), *exec, preBatchStats);
+        }
+
         // We have to do this before re-acquiring locks in the agg case because
         // shouldSaveCursorGetMore() can make a network call for agg cursors.
         //
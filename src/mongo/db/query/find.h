@@ -34,6 +34,7 @@
 #include "mongo/db/dbmessage.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/explain.h"
 #include "mongo/util/net/message.h"
 
 namespace mongo {
@@ -99,6 +100,16 @@ void endQueryOp(OperationContext* txn,
                 long long numResults,
                 CursorId cursorId);
 
+/**
+ * Reports the keys examined, documents examined and results returned by one getMore batch of
+ * 'exec' to the query shape statistics of 'collection'. 'preBatchStats' must hold the summary
+ * stats of 'exec' from before the batch was generated. Does nothing if 'collection' is null.
+ */
+void endGetMoreBatch(OperationContext* txn,
+                     Collection* collection,
+                     const PlanExecutor& exec,
+                     const PlanSummaryStats& preBatchStats);
+
 /**
  * Constructs a PlanExecutor for a query with the oplogReplay option set to true,
  * for the query 'cq' over the collection 'collection'. The PlanExecutor will
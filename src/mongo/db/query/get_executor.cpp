@@ -36,16 +36,19 @@
 #include <memory>
 
 #include "mongo/base/error_codes.h"
+#include "mongo/base/owned_pointer_vector.h"
 #include "mongo/base/parse_number.h"
 #include "mongo/client/dbclientinterface.h"
 #include "mongo/db/exec/cached_plan.h"
 #include "mongo/db/exec/count.h"
+#include "mongo/db/exec/count_scan.h"
 #include "mongo/db/exec/delete.h"
 #include "mongo/db/exec/eof.h"
 #include "mongo/db/exec/group.h"
 #include "mongo/db/exec/idhack.h"
 #include "mongo/db/exec/multi_plan.h"
 #include "mongo/db/exec/oplogstart.h"
+#include "mongo/db/exec/or.h"
 #include "mongo/db/exec/projection.h"
 #include "mongo/db/exec/shard_filter.h"
 #include "mongo/db/exec/sort_key_generator.h"
@@ -53,6 +56,7 @@
 #include "mongo/db/exec/update.h"
 #include "mongo/db/index_names.h"
 #include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/keypattern.h"
 #include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
@@ -188,6 +192,10 @@ void fillOutPlannerParams(OperationContext* txn,
         plannerParams->options |= QueryPlannerParams::INDEX_INTERSECTION;
     }
 
+    if (internalQueryPlannerEnableSkipScan) {
+        plannerParams->options |= QueryPlannerParams::SKIP_SCAN;
+    }
+
     plannerParams->options |= QueryPlannerParams::SPLIT_LIMITED_SORT;
 
     // Doc-level locking storage engines cannot answer predicates implicitly via exact index
@@ -577,7 +585,7 @@ StatusWith<unique_ptr<PlanExecutor>> getExecutorFind(OperationContext* txn,
         return getOplogStartHack(txn, collection, std::move(canonicalQuery));
     }
 
-    size_t options = QueryPlannerParams::DEFAULT;
+    size_t options = QueryPlannerParams::PRIVATE_IS_FIND;
     if (ShardingState::get(txn)->needCollectionMetadata(txn, nss.ns())) {
         options |= QueryPlannerParams::INCLUDE_SHARD_FILTER;
     }
@@ -1143,8 +1151,131 @@ BSONObj getDistinctProjection(const std::string& field) {
     return bob.obj();
 }
 
+/**
+ * Finds the bounds of a single-interval scan over 'descriptor' which answers the predicate of 'cq'
+ * exactly, so that the documents matching it can be counted from index keys alone. Returns false
+ * if the predicate cannot be answered that way.
+ */
+bool getExactCountScanBounds(OperationContext* txn,
+                             const CanonicalQuery& cq,
+                             const IndexDescriptor* descriptor,
+                             CountScanParams* countScanParams) {
+    countScanParams->descriptor = descriptor;
+
+    const bool isEmptyQueryPredicate =
+        cq.root()->matchType() == MatchExpression::AND && cq.root()->numChildren() == 0;
+    if (isEmptyQueryPredicate) {
+        const KeyPattern indexKeyPattern(descriptor->keyPattern());
+        countScanParams->startKey = indexKeyPattern.globalMin();
+        countScanParams->startKeyInclusive = true;
+        countScanParams->endKey = indexKeyPattern.globalMax();
+        countScanParams->endKeyInclusive = true;
+        return true;
+    }
+
+    // Plan the query against the given index only, and see whether any of the solutions is a
+    // fast count.
+    QueryPlannerParams plannerParams;
+    plannerParams.options =
+        QueryPlannerParams::PRIVATE_IS_COUNT | QueryPlannerParams::NO_TABLE_SCAN;
+    plannerParams.indices.push_back(IndexEntry(descriptor->keyPattern(),
+                                               descriptor->getAccessMethodName(),
+                                               descriptor->isMultikey(txn),
+                                               descriptor->isSparse(),
+                                               descriptor->unique(),
+                                               descriptor->indexName(),
+                                               nullptr,
+                                               descriptor->infoObj()));
+
+    OwnedPointerVector<QuerySolution> solutions;
+    if (!QueryPlanner::plan(cq, plannerParams, &solutions.mutableVector()).isOK()) {
+        return false;
+    }
+
+    for (QuerySolution* soln : solutions.vector()) {
+        if (!turnIxscanIntoCount(soln)) {
+            continue;
+        }
+
+        const CountScanNode* csn = static_cast<const CountScanNode*>(soln->root.get());
+        countScanParams->startKey = csn->startKey;
+        countScanParams->startKeyInclusive = csn->startKeyInclusive;
+        countScanParams->endKey = csn->endKey;
+        countScanParams->endKeyInclusive = csn->endKeyInclusive;
+
+        // Chunk ranges are clipped assuming the scan runs forward through the index.
+        return countScanParams->startKey.woCompare(
+                   countScanParams->endKey, descriptor->keyPattern(), false) <= 0;
+    }
+
+    return false;
+}
+
+/**
+ * Restricts the scan described by 'countScanParams' to the shard key range [rangeMin, rangeMax).
+ * Returns false if the two ranges do not overlap.
+ */
+bool clipCountScanToRange(const BSONObj& rangeMin,
+                          const BSONObj& rangeMax,
+                          CountScanParams* countScanParams) {
+    const BSONObj indexKeyPattern = countScanParams->descriptor->keyPattern();
+    const KeyPattern keyPattern(indexKeyPattern);
+    const BSONObj min = keyPattern.extendRangeBound(rangeMin, false);
+    const BSONObj max = keyPattern.extendRangeBound(rangeMax, false);
+
+    const int startCmp = min.woCompare(countScanParams->startKey, indexKeyPattern, false);
+    if (startCmp > 0) {
+        countScanParams->startKey = min;
+        countScanParams->startKeyInclusive = true;
+    }
+
+    const int endCmp = max.woCompare(countScanParams->endKey, indexKeyPattern, false);
+    if (endCmp <= 0) {
+        countScanParams->endKey = max;
+        countScanParams->endKeyInclusive = false;
+    }
+
+    const int cmp = countScanParams->startKey.woCompare(
+        countScanParams->endKey, indexKeyPattern, false);
+    return cmp < 0 ||
+        (cmp == 0 && countScanParams->startKeyInclusive && countScanParams->endKeyInclusive);
+}
+
 }  // namespace
 
+unique_ptr<PlanStage> getOwnedRangesCountScan(OperationContext* txn,
+                                              Collection* collection,
+                                              WorkingSet* ws,
+                                              const CanonicalQuery& cq,
+                                              const BSONObj& shardKeyPattern,
+                                              const RangeMap& ownedRanges) {
+    const IndexDescriptor* descriptor = collection->getIndexCatalog()->findShardKeyPrefixedIndex(
+        txn, shardKeyPattern, true);  // requireSingleKey
+    if (!descriptor || descriptor->isSparse() || descriptor->isPartial()) {
+        return nullptr;
+    }
+
+    CountScanParams queryBounds;
+    if (!getExactCountScanBounds(txn, cq, descriptor, &queryBounds)) {
+        return nullptr;
+    }
+
+    // The owned ranges are disjoint, so the union of their scans does not need deduplication.
+    auto orStage = make_unique<OrStage>(txn, ws, false, nullptr);
+
+    for (const auto& range : ownedRanges) {
+        CountScanParams rangeBounds = queryBounds;
+        if (clipCountScanToRange(range.first, range.second, &rangeBounds)) {
+            orStage->addChild(new CountScan(txn, rangeBounds, ws));
+        }
+    }
+
+    LOG(2) << "Using shard key index count over owned ranges: " << cq.toStringShort()
+           << ", index: " << descriptor->indexName();
+
+    return std::move(orStage);
+}
+
 StatusWith<unique_ptr<PlanExecutor>> getExecutorCount(OperationContext* txn,
                                                       Collection* collection,
                                                       const CountRequest& request,
@@ -1183,6 +1314,37 @@ StatusWith<unique_ptr<PlanExecutor>> getExecutorCount(OperationContext* txn,
             txn, std::move(ws), std::move(root), request.getNs().ns(), yieldPolicy);
     }
 
+    // When enabled, a count on a sharded collection must not include orphaned documents, so
+    // neither the collection's number of records nor a plain index count can be used. If the
+    // predicate can be answered from the shard key index, count its keys within the ranges this
+    // shard owns. Otherwise fall back to filtering every matching document by shard ownership.
+    std::shared_ptr<CollectionMetadata> collMetadata;
+    if (internalQueryCountFilterOrphans &&
+        ShardingState::get(txn)->needCollectionMetadata(txn, request.getNs().ns())) {
+        collMetadata = ShardingState::get(txn)->getCollectionMetadata(request.getNs().ns());
+    }
+
+    if (collMetadata && request.getHint().isEmpty()) {
+        unique_ptr<PlanStage> child = getOwnedRangesCountScan(txn,
+                                                              collection,
+                                                              ws.get(),
+                                                              *cq.getValue(),
+                                                              collMetadata->getKeyPattern(),
+                                                              collMetadata->getOwnedRanges());
+        if (child) {
+            const bool useRecordStoreCount = false;
+            CountStageParams params(request, useRecordStoreCount);
+            unique_ptr<PlanStage> root = make_unique<CountStage>(
+                txn, collection, std::move(params), ws.get(), child.release());
+            return PlanExecutor::make(txn,
+                                      std::move(ws),
+                                      std::move(root),
+                                      std::move(cq.getValue()),
+                                      collection,
+                                      yieldPolicy);
+        }
+    }
+
     // If the query is empty, then we can determine the count by just asking the collection
     // for its number of records. This is implemented by the CountStage, and we don't need
     // to create a child for the count stage in this case.
@@ -1190,7 +1352,8 @@ StatusWith<unique_ptr<PlanExecutor>> getExecutorCount(OperationContext* txn,
     // If there is a hint, then we can't use a trival count plan as described above.
     const bool isEmptyQueryPredicate = cq.getValue()->root()->matchType() == MatchExpression::AND &&
         cq.getValue()->root()->numChildren() == 0;
-    const bool useRecordStoreCount = isEmptyQueryPredicate && request.getHint().isEmpty();
+    const bool useRecordStoreCount =
+        isEmptyQueryPredicate && request.getHint().isEmpty() && !collMetadata;
     CountStageParams params(request, useRecordStoreCount);
 
     if (useRecordStoreCount) {
@@ -1200,7 +1363,10 @@ StatusWith<unique_ptr<PlanExecutor>> getExecutorCount(OperationContext* txn,
             txn, std::move(ws), std::move(root), request.getNs().ns(), yieldPolicy);
     }
 
-    const size_t plannerOptions = QueryPlannerParams::PRIVATE_IS_COUNT;
+    size_t plannerOptions = QueryPlannerParams::PRIVATE_IS_COUNT;
+    if (collMetadata) {
+        plannerOptions |= QueryPlannerParams::INCLUDE_SHARD_FILTER;
+    }
     PlanStage* child;
     QuerySolution* rawQuerySolution;
     Status prepStatus = prepareExecution(
@@ -36,6 +36,7 @@
 #include "mongo/db/ops/parsed_update.h"
 #include "mongo/db/ops/update_driver.h"
 #include "mongo/db/ops/update_request.h"
+#include "mongo/db/range_arithmetic.h"
 
 namespace mongo {
 
@@ -117,6 +118,21 @@ StatusWith<std::unique_ptr<PlanExecutor>> getExecutorDistinct(
     bool isExplain,
     PlanExecutor::YieldPolicy yieldPolicy);
 
+/**
+ * Builds a plan which counts the documents matching 'cq' whose shard key, described by
+ * 'shardKeyPattern', falls into one of 'ownedRanges'. Only the keys of the shard key index within
+ * those ranges are scanned, and documents are never fetched, so orphans cost nothing.
+ *
+ * Returns nullptr if 'collection' has no usable shard key index, or if the predicate cannot be
+ * answered exactly from it. Exposed for testing.
+ */
+std::unique_ptr<PlanStage> getOwnedRangesCountScan(OperationContext* txn,
+                                                   Collection* collection,
+                                                   WorkingSet* ws,
+                                                   const CanonicalQuery& cq,
+                                                   const BSONObj& shardKeyPattern,
+                                                   const RangeMap& ownedRanges);
+
 /*
  * Get a PlanExecutor for a query executing as part of a count command.
  *
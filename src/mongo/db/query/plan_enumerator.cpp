@@ -34,6 +34,7 @@
 
 #include "mongo/db/query/indexability.h"
 #include "mongo/db/query/index_tag.h"
+#include "mongo/db/query/planner_ixselect.h"
 #include "mongo/util/log.h"
 
 namespace {
@@ -62,6 +63,22 @@ bool expressionRequiresIndex(const MatchExpression* node) {
         CanonicalQuery::countNodes(node, MatchExpression::TEXT) > 0;
 }
 
+/**
+ * Returns the position of the field 'path' in the key pattern of 'index'.
+ */
+size_t getPositionInIndex(const IndexEntry& index, const std::string& path) {
+    size_t pos = 0;
+    BSONObjIterator it(index.keyPattern);
+    while (it.more()) {
+        if (it.next().fieldName() == path) {
+            return pos;
+        }
+        ++pos;
+    }
+    invariant(false);
+    return 0;
+}
+
 }  // namespace
 
 
@@ -71,6 +88,7 @@ PlanEnumerator::PlanEnumerator(const PlanEnumeratorParams& params)
     : _root(params.root),
       _indices(params.indices),
       _ixisect(params.intersect),
+      _skipScan(params.skipScan),
       _orLimit(params.maxSolutionsPerOr),
       _intersectLimit(params.maxIntersectPerAnd) {}
 
@@ -222,8 +240,17 @@ bool PlanEnumerator::prepMemo(MatchExpression* node, PrepMemoContext context) {
         // In order to definitely use an index it must be prefixed with our field.
         // We don't consider notFirst indices here because we must be AND-related to a node
         // that uses the first spot in that index, and we currently do not know that
-        // unless we're in an AND node.
-        if (0 == rt->first.size()) {
+        // unless we're in an AND node. The exception is an index we can skip scan.
+        vector<IndexID> skipScanIndices;
+        if (_skipScan) {
+            for (size_t i = 0; i < rt->notFirst.size(); ++i) {
+                if (QueryPlannerIXSelect::canSkipScan((*_indices)[rt->notFirst[i]])) {
+                    skipScanIndices.push_back(rt->notFirst[i]);
+                }
+            }
+        }
+
+        if (0 == rt->first.size() && skipScanIndices.empty()) {
             return false;
         }
 
@@ -235,6 +262,12 @@ bool PlanEnumerator::prepMemo(MatchExpression* node, PrepMemoContext context) {
         assign->pred.reset(new PredicateAssignment());
         assign->pred->expr = node;
         assign->pred->first.swap(rt->first);
+        assign->pred->positions.resize(assign->pred->first.size(), 0);
+        for (size_t i = 0; i < skipScanIndices.size(); ++i) {
+            assign->pred->first.push_back(skipScanIndices[i]);
+            assign->pred->positions.push_back(
+                getPositionInIndex((*_indices)[skipScanIndices[i]], rt->path));
+        }
         return true;
     } else if (Indexability::isBoundsGeneratingNot(node)) {
         bool childIndexable = prepMemo(node->getChild(0), childContext);
@@ -386,8 +419,16 @@ bool PlanEnumerator::prepMemo(MatchExpression* node, PrepMemoContext context) {
             }
         }
 
+        // Compound indices without a predicate over their leading field may still be usable
+        // by skip scanning.
+        vector<OneIndexAssignment> skipScanAssignments;
+        if (_skipScan) {
+            getSkipScanAssignments(idxToFirst, idxToNotFirst, &skipScanAssignments);
+        }
+
         // If none of our children can use indices, bail out.
-        if (idxToFirst.empty() && (subnodes.size() == 0) && (mandatorySubnodes.size() == 0)) {
+        if (idxToFirst.empty() && (subnodes.size() == 0) && (mandatorySubnodes.size() == 0) &&
+            skipScanAssignments.empty()) {
             return false;
         }
 
@@ -418,6 +459,12 @@ bool PlanEnumerator::prepMemo(MatchExpression* node, PrepMemoContext context) {
 
         enumerateOneIndex(idxToFirst, idxToNotFirst, subnodes, andAssignment);
 
+        for (size_t i = 0; i < skipScanAssignments.size(); ++i) {
+            AndEnumerableState state;
+            state.assignments.push_back(skipScanAssignments[i]);
+            andAssignment->choices.push_back(state);
+        }
+
         if (_ixisect) {
             enumerateAndIntersect(idxToFirst, idxToNotFirst, subnodes, andAssignment);
         }
@@ -1096,6 +1143,29 @@ bool PlanEnumerator::alreadyCompounded(const set<MatchExpression*>& ixisectAssig
     return false;
 }
 
+void PlanEnumerator::getSkipScanAssignments(const IndexToPredMap& idxToFirst,
+                                            const IndexToPredMap& idxToNotFirst,
+                                            vector<OneIndexAssignment>* out) {
+    for (IndexToPredMap::const_iterator it = idxToNotFirst.begin(); it != idxToNotFirst.end();
+         ++it) {
+        // An index with a predicate over its leading field is assigned the usual way.
+        if (idxToFirst.end() != idxToFirst.find(it->first)) {
+            continue;
+        }
+
+        const IndexEntry& thisIndex = (*_indices)[it->first];
+        if (!QueryPlannerIXSelect::canSkipScan(thisIndex)) {
+            continue;
+        }
+
+        OneIndexAssignment assign;
+        assign.index = it->first;
+        compound(it->second, thisIndex, &assign);
+        invariant(!assign.preds.empty());
+        out->push_back(assign);
+    }
+}
+
 void PlanEnumerator::compound(const vector<MatchExpression*>& tryCompound,
                               const IndexEntry& thisIndex,
                               OneIndexAssignment* assign) {
@@ -1147,7 +1217,8 @@ void PlanEnumerator::tagMemo(size_t id) {
         PredicateAssignment* pa = assign->pred.get();
         verify(NULL == pa->expr->getTag());
         verify(pa->indexToAssign < pa->first.size());
-        pa->expr->setTag(new IndexTag(pa->first[pa->indexToAssign]));
+        pa->expr->setTag(
+            new IndexTag(pa->first[pa->indexToAssign], pa->positions[pa->indexToAssign]));
     } else if (NULL != assign->orAssignment) {
         OrAssignment* oa = assign->orAssignment.get();
         for (size_t i = 0; i < oa->subnodes.size(); ++i) {
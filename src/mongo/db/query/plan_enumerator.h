@@ -42,6 +42,7 @@ namespace mongo {
 struct PlanEnumeratorParams {
     PlanEnumeratorParams()
         : intersect(false),
+          skipScan(false),
           maxSolutionsPerOr(internalQueryEnumerationMaxOrSolutions),
           maxIntersectPerAnd(internalQueryEnumerationMaxIntersectPerAnd) {}
 
@@ -49,6 +50,10 @@ struct PlanEnumeratorParams {
     // an indexed solution?
     bool intersect;
 
+    // Do we provide solutions that use a compound index for predicates over its trailing fields
+    // alone, by skip scanning over the distinct values of its leading field?
+    bool skipScan;
+
     // Not owned here.
     MatchExpression* root;
 
@@ -177,12 +182,17 @@ private:
         PredicateAssignment() : indexToAssign(0) {}
 
         std::vector<IndexID> first;
+
+        // 'expr' uses index 'first[i]' at position 'positions[i]'. The position is 0 unless
+        // the index is to be skip scanned.
+        std::vector<IndexPosition> positions;
+
         // Not owned here.
         MatchExpression* expr;
 
         // Enumeration state.  An indexed predicate's possible states are the indices that the
-        // predicate can directly use (the 'first' indices).  As such this value ranges from 0
-        // to first.size()-1 inclusive.
+        // predicate can directly use (the 'first' indices, followed by any indices it can skip
+        // scan).  As such this value ranges from 0 to first.size()-1 inclusive.
         size_t indexToAssign;
     };
 
@@ -398,6 +408,15 @@ private:
                                  const std::set<IndexID>& mandatoryIndices,
                                  AndAssignment* andAssignment);
 
+    /**
+     * Generate assignments of the predicates in idxToNotFirst to each compound index which has no
+     * predicate over its leading field, but which can be skip scanned. Outputs the assignments
+     * into 'out'.
+     */
+    void getSkipScanAssignments(const IndexToPredMap& idxToFirst,
+                                const IndexToPredMap& idxToNotFirst,
+                                std::vector<OneIndexAssignment>* out);
+
     /**
      * Try to assign predicates in 'tryCompound' to 'thisIndex' as compound assignments.
      * Output the assignments in 'assign'.
@@ -437,6 +456,9 @@ private:
     // Do we output >1 index per AND (index intersection)?
     bool _ixisect;
 
+    // Do we output skip scan assignments?
+    bool _skipScan;
+
     // How many enumerations are we willing to produce from each OR?
     size_t _orLimit;
 
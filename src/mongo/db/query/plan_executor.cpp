@@ -462,6 +462,21 @@ PlanExecutor::ExecState PlanExecutor::getNextImpl(Snapshotted<BSONObj>* objOut,
             if (_yieldPolicy->allowedToYield())
                 _yieldPolicy->forceYield();
         } else if (PlanStage::NEED_TIME == code) {
+            // A cached plan at the root of a find may ask to be replanned. Its new trial period
+            // runs here, between calls to work(), so that it yields under our yield policy.
+            if (STAGE_CACHED_PLAN == _root->stageType()) {
+                CachedPlanStage* cachedPlan = static_cast<CachedPlanStage*>(_root.get());
+                if (cachedPlan->needsMidQueryReplan()) {
+                    Status status = cachedPlan->replanMidQuery(_yieldPolicy.get());
+                    if (!status.isOK()) {
+                        if (NULL != objOut) {
+                            *objOut = Snapshotted<BSONObj>(
+                                SnapshotId(), WorkingSetCommon::buildMemberStatusObject(status));
+                        }
+                        return killed() ? PlanExecutor::DEAD : PlanExecutor::FAILURE;
+                    }
+                }
+            }
             // Fall through to yield check at end of large conditional.
         } else if (PlanStage::IS_EOF == code) {
             return PlanExecutor::IS_EOF;
@@ -163,7 +163,7 @@ size_t PlanRanker::pickBestPlan(const vector<CandidatePlan>& candidates, PlanRan
 // TODO: Move this out.  This is a signal for ranking but will become its own complicated
 // stats-collecting beast.
 double computeSelectivity(const PlanStageStats* stats) {
-    if (STAGE_IXSCAN == stats->stageType) {
+    if (STAGE_IXSCAN == stats->stageType || STAGE_MERGE_IXSCAN == stats->stageType) {
         IndexScanStats* iss = static_cast<IndexScanStats*>(stats->specific.get());
         return iss->keyPattern.nFields();
     } else {
@@ -233,7 +233,8 @@ double PlanRanker::scoreTree(const PlanStageStats* stats) {
     // allows us to examine fewer documents, the penalty given to ixisect
     // can be made up via the no fetch bonus.
     double noIxisectBonus = epsilon;
-    if (hasStage(STAGE_AND_HASH, stats) || hasStage(STAGE_AND_SORTED, stats)) {
+    if (hasStage(STAGE_AND_HASH, stats) || hasStage(STAGE_AND_SORTED, stats) ||
+        hasStage(STAGE_AND_BITMAP, stats)) {
         noIxisectBonus = 0;
     }
 
@@ -250,7 +251,8 @@ double PlanRanker::scoreTree(const PlanStageStats* stats) {
     LOG(2) << scoreStr;
 
     if (internalQueryForceIntersectionPlans) {
-        if (hasStage(STAGE_AND_HASH, stats) || hasStage(STAGE_AND_SORTED, stats)) {
+        if (hasStage(STAGE_AND_HASH, stats) || hasStage(STAGE_AND_SORTED, stats) ||
+            hasStage(STAGE_AND_BITMAP, stats)) {
             // The boost should be >2.001 to make absolutely sure the ixisect plan will win due
             // to the combination of 1) productivity, 2) eof bonus, and 3) no ixisect bonus.
             score += 3;
@@ -964,6 +964,13 @@ QuerySolutionNode* QueryPlannerAccess::buildIndexedAnd(const CanonicalQuery& que
             AndSortedNode* asn = new AndSortedNode();
             asn->children.swap(ixscanNodes);
             andResult = asn;
+        } else if (internalQueryPlannerEnableBitmapIntersection &&
+                   (params.options & QueryPlannerParams::CANNOT_TRIM_IXISECT)) {
+            // The bitmap AND keeps no index keys for the documents it outputs, so it relies on
+            // the FETCH added below to recheck the entire predicate.
+            AndBitmapNode* abn = new AndBitmapNode();
+            abn->children.swap(ixscanNodes);
+            andResult = abn;
         } else if (internalQueryPlannerEnableHashIntersection) {
             AndHashNode* ahn = new AndHashNode();
             ahn->children.swap(ixscanNodes);
@@ -980,10 +987,11 @@ QuerySolutionNode* QueryPlannerAccess::buildIndexedAnd(const CanonicalQuery& que
                 }
             }
         } else {
-            // We can't use sort-based intersection, and hash-based intersection is disabled.
+            // We can't use sort-based intersection, and hash-based and bitmap-based intersection
+            // are disabled.
             // Clean up the index scans and bail out by returning NULL.
             LOG(5) << "Can't build index intersection solution: "
-                   << "AND_SORTED is not possible and AND_HASH is disabled.";
+                   << "AND_SORTED is not possible and AND_HASH and AND_BITMAP are disabled.";
 
             for (size_t i = 0; i < ixscanNodes.size(); i++) {
                 delete ixscanNodes[i];
@@ -999,7 +1007,8 @@ QuerySolutionNode* QueryPlannerAccess::buildIndexedAnd(const CanonicalQuery& que
 
     // XXX: This block is a hack to accommodate the storage layer concurrency model.
     if ((params.options & QueryPlannerParams::CANNOT_TRIM_IXISECT) &&
-        (andResult->getType() == STAGE_AND_HASH || andResult->getType() == STAGE_AND_SORTED)) {
+        (andResult->getType() == STAGE_AND_HASH || andResult->getType() == STAGE_AND_SORTED ||
+         andResult->getType() == STAGE_AND_BITMAP)) {
         // We got an index intersection solution, and we aren't allowed to answer predicates
         // using the index. We add a fetch with the entire filter.
         invariant(clonedRoot.get());
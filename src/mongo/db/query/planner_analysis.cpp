@@ -229,6 +229,27 @@ void explodeScan(IndexScanNode* isn,
     }
 }
 
+/**
+ * Returns a MERGE_IXSCAN which is logically equivalent to a MergeSort over the result of
+ * explodeScan() for 'isn' and 'fieldsToExplode'. The new node is owned by the caller.
+ */
+MergeIndexScanNode* makeMergeIndexScan(IndexScanNode* isn, size_t fieldsToExplode) {
+    MergeIndexScanNode* mergeScan = new MergeIndexScanNode();
+    mergeScan->indexKeyPattern = isn->indexKeyPattern;
+    mergeScan->direction = isn->direction;
+    mergeScan->maxScan = isn->maxScan;
+    mergeScan->addKeyMetadata = isn->addKeyMetadata;
+    mergeScan->indexIsMultiKey = isn->indexIsMultiKey;
+    mergeScan->bounds = isn->bounds;
+    mergeScan->numPointPrefixFields = fieldsToExplode;
+
+    if (isn->filter.get()) {
+        mergeScan->filter = isn->filter->shallowClone();
+    }
+
+    return mergeScan;
+}
+
 /**
  * In the tree '*root', replace 'oldNode' with 'newNode'.
  */
@@ -420,8 +441,11 @@ bool QueryPlannerAnalysis::explodeForSort(const CanonicalQuery& query,
         fieldsToExplode.push_back(boundsIdx);
     }
 
-    // Too many ixscans spoil the performance.
-    if (totalNumScans > (size_t)internalQueryMaxScansToExplode) {
+    // Too many ixscans spoil the performance. Instead of one ixscan per point prefix, we can
+    // merge all of the point prefixes of each leaf within a single MERGE_IXSCAN stage.
+    const bool mergeInsteadOfExplode = totalNumScans > (size_t)internalQueryMaxScansToExplode;
+    if (mergeInsteadOfExplode &&
+        totalNumScans > (size_t)internalQueryMaxIntervalsToMergeForSort) {
         LOG(5) << "Could expand ixscans to pull out sort order but resulting scan count"
                << "(" << totalNumScans << ") is too high.";
         return false;
@@ -433,13 +457,25 @@ bool QueryPlannerAnalysis::explodeForSort(const CanonicalQuery& query,
     merge->sort = desiredSort;
     for (size_t i = 0; i < leafNodes.size(); ++i) {
         IndexScanNode* isn = static_cast<IndexScanNode*>(leafNodes[i]);
-        explodeScan(isn, desiredSort, fieldsToExplode[i], &merge->children);
+        if (mergeInsteadOfExplode) {
+            merge->children.push_back(makeMergeIndexScan(isn, fieldsToExplode[i]));
+        } else {
+            explodeScan(isn, desiredSort, fieldsToExplode[i], &merge->children);
+        }
+    }
+
+    // A single merged scan provides the sort order by itself.
+    QuerySolutionNode* replacement = merge;
+    if (1 == merge->children.size() && mergeInsteadOfExplode) {
+        replacement = merge->children[0];
+        merge->children.clear();
+        delete merge;
     }
 
-    merge->computeProperties();
+    replacement->computeProperties();
 
-    // Replace 'toReplace' with the new merge sort node.
-    replaceNodeInTree(solnRoot, toReplace, merge);
+    // Replace 'toReplace' with the node providing the sort.
+    replaceNodeInTree(solnRoot, toReplace, replacement);
     // And get rid of the node that got replaced.
     delete toReplace;
 
@@ -648,7 +684,8 @@ QuerySolution* QueryPlannerAnalysis::analyzeDataAccess(const CanonicalQuery& que
     // A solution can be blocking if it has a blocking sort stage or
     // a hashed AND stage.
     bool hasAndHashStage = hasNode(solnRoot, STAGE_AND_HASH);
-    soln->hasBlockingStage = hasSortStage || hasAndHashStage;
+    soln->hasBlockingStage =
+        hasSortStage || hasAndHashStage || hasNode(solnRoot, STAGE_AND_BITMAP);
 
     const LiteParsedQuery& lpq = query.getParsed();
 
@@ -757,8 +794,9 @@ QuerySolution* QueryPlannerAnalysis::analyzeDataAccess(const CanonicalQuery& que
                     getLeafNodes(solnRoot, &leafNodes);
 
                     if (1 == leafNodes.size()) {
-                        // Both the IXSCAN and DISTINCT stages provide covered key data.
-                        if (STAGE_IXSCAN == leafNodes[0]->getType()) {
+                        // The IXSCAN, MERGE_IXSCAN and DISTINCT stages provide covered key data.
+                        if (STAGE_IXSCAN == leafNodes[0]->getType() ||
+                            STAGE_MERGE_IXSCAN == leafNodes[0]->getType()) {
                             projType = ProjectionNode::COVERED_ONE_INDEX;
                             IndexScanNode* ixn = static_cast<IndexScanNode*>(leafNodes[0]);
                             coveredKeyObj = ixn->indexKeyPattern;
@@ -120,6 +120,38 @@ void QueryPlannerIXSelect::findRelevantIndices(const unordered_set<string>& fiel
     }
 }
 
+// static
+bool QueryPlannerIXSelect::canSkipScan(const IndexEntry& index) {
+    // The index scan seeks past each distinct value of the leading field on its own when the
+    // bounds on that field are [MinKey, MaxKey].
+    return INDEX_BTREE == index.type && !index.multikey;
+}
+
+// static
+void QueryPlannerIXSelect::findSkipScanIndices(const unordered_set<string>& fields,
+                                               const vector<IndexEntry>& allIndices,
+                                               vector<IndexEntry>* out) {
+    for (size_t i = 0; i < allIndices.size(); ++i) {
+        if (!canSkipScan(allIndices[i])) {
+            continue;
+        }
+
+        BSONObjIterator it(allIndices[i].keyPattern);
+        verify(it.more());
+        if (fields.end() != fields.find(it.next().fieldName())) {
+            // Already found by findRelevantIndices().
+            continue;
+        }
+
+        while (it.more()) {
+            if (fields.end() != fields.find(it.next().fieldName())) {
+                out->push_back(allIndices[i]);
+                break;
+            }
+        }
+    }
+}
+
 // static
 bool QueryPlannerIXSelect::compatible(const BSONElement& elt,
                                       const IndexEntry& index,
@@ -59,6 +59,21 @@ public:
                                     const std::vector<IndexEntry>& indices,
                                     std::vector<IndexEntry>* out);
 
+    /**
+     * Returns true if predicates over the trailing fields of 'index' can be answered without a
+     * predicate over its leading field, by seeking to each distinct value of the leading field in
+     * turn.
+     */
+    static bool canSkipScan(const IndexEntry& index);
+
+    /**
+     * Find all indices which we can skip scan, which are not prefixed by a field we have
+     * predicates over but have some other field we have predicates over. Appends them to 'out'.
+     */
+    static void findSkipScanIndices(const unordered_set<std::string>& fields,
+                                    const std::vector<IndexEntry>& indices,
+                                    std::vector<IndexEntry>* out);
+
     /**
      * Return true if the index key pattern field 'elt' (which belongs to 'index') can be used
      * to answer the predicate 'node'.
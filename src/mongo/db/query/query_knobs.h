@@ -58,6 +58,14 @@ extern std::atomic<bool> internalQueryPlannerEnableIndexIntersection;  // NOLINT
 // Do we use hash-based intersection for rooted $and queries?
 extern std::atomic<bool> internalQueryPlannerEnableHashIntersection;  // NOLINT
 
+// Do we use bitmap-based intersection for rooted $and queries? Only applies to storage engines
+// which recheck the full predicate above index intersection plans. Off by default: these plans
+// are only costed by the multi-plan trial, like hash intersection plans.
+extern std::atomic<bool> internalQueryPlannerEnableBitmapIntersection;  // NOLINT
+
+// Do we consider skip scanning compound indices which have no predicate over their leading field?
+extern std::atomic<bool> internalQueryPlannerEnableSkipScan;  // NOLINT
+
 //
 // plan cache
 //
@@ -73,6 +81,16 @@ extern std::atomic<int> internalQueryCacheFeedbacksStored;  // NOLINT
 // and replanning?
 extern AtomicDouble internalQueryCacheEvictionRatio;  // NOLINT
 
+// Do we keep checking a cached plan's productivity after its trial period, and replan the query
+// mid-stream if it falls behind? Only applies to plans at the root of a find.
+extern std::atomic<bool> internalQueryCacheEnableMidQueryReplanning;  // NOLINT
+
+// How many query shapes per collection do we collect execution statistics for? Zero disables
+// collection of query shape statistics. The limit is read when a collection's info cache is
+// created, so a runtime change only applies to collections loaded afterwards. Setting it to zero
+// disables recording on all collections immediately.
+extern std::atomic<int> internalQueryShapeStatsMaxEntries;  // NOLINT
+
 //
 // Planning and enumeration.
 //
@@ -93,6 +111,10 @@ extern std::atomic<bool> internalQueryPlanOrChildrenIndependently;  // NOLINT
 // during explodeForSort?
 extern std::atomic<int> internalQueryMaxScansToExplode;  // NOLINT
 
+// When explodeForSort would need more index scans than internalQueryMaxScansToExplode, how many
+// point intervals are we willing to merge within a single MERGE_IXSCAN stage instead?
+extern std::atomic<int> internalQueryMaxIntervalsToMergeForSort;  // NOLINT
+
 //
 // Query execution.
 //
@@ -105,6 +127,11 @@ extern std::atomic<int> internalQueryExecYieldIterations;  // NOLINT
 // Yield if it's been at least this many milliseconds since we last yielded.
 extern std::atomic<int> internalQueryExecYieldPeriodMS;  // NOLINT
 
+// Does count on a sharded collection leave out orphaned documents? If so, the shard key index is
+// counted over the owned chunk ranges when it can answer the predicate, and every matching
+// document is filtered by shard ownership otherwise.
+extern std::atomic<bool> internalQueryCountFilterOrphans;  // NOLINT
+
 // Limit the size that we write without yielding to 16MB / 64 (max expected number of indexes)
 const int64_t insertVectorMaxBytes = 256 * 1024;
 
@@ -99,7 +99,10 @@ string optionString(size_t options) {
         ss << "INDEX_INTERSECTION ";
     }
     if (options & QueryPlannerParams::KEEP_MUTATIONS) {
-        ss << "KEEP_MUTATIONS";
+        ss << "KEEP_MUTATIONS ";
+    }
+    if (options & QueryPlannerParams::SKIP_SCAN) {
+        ss << "SKIP_SCAN ";
     }
 
     return ss;
@@ -530,6 +533,9 @@ Status QueryPlanner::plan(const CanonicalQuery& query,
 
     if (hintIndex.isEmpty()) {
         QueryPlannerIXSelect::findRelevantIndices(fields, params.indices, &relevantIndices);
+        if (params.options & QueryPlannerParams::SKIP_SCAN) {
+            QueryPlannerIXSelect::findSkipScanIndices(fields, params.indices, &relevantIndices);
+        }
     } else {
         // Sigh.  If the hint is specified it might be using the index name.
         BSONElement firstHintElt = hintIndex.firstElement();
@@ -734,6 +740,7 @@ Status QueryPlanner::plan(const CanonicalQuery& query,
         // The enumerator spits out trees tagged with IndexTag(s).
         PlanEnumeratorParams enumParams;
         enumParams.intersect = params.options & QueryPlannerParams::INDEX_INTERSECTION;
+        enumParams.skipScan = params.options & QueryPlannerParams::SKIP_SCAN;
         enumParams.root = query.root();
         enumParams.indices = &relevantIndices;
 
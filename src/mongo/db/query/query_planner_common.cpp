@@ -39,7 +39,7 @@ namespace mongo {
 void QueryPlannerCommon::reverseScans(QuerySolutionNode* node) {
     StageType type = node->getType();
 
-    if (STAGE_IXSCAN == type) {
+    if (STAGE_IXSCAN == type || STAGE_MERGE_IXSCAN == type) {
         IndexScanNode* isn = static_cast<IndexScanNode*>(node);
         isn->direction *= -1;
 
@@ -95,6 +95,16 @@ struct QueryPlannerParams {
         // Set this if you don't want any plans with a non-covered projection stage. All projections
         // must be provided/covered by an index.
         NO_UNCOVERED_PROJECTIONS = 1 << 10,
+
+        // Set this if you want the planner to consider skip scans: using a compound index for
+        // predicates over its trailing fields alone by seeking to each distinct value of its
+        // leading field in turn.
+        SKIP_SCAN = 1 << 11,
+
+        // Nobody should set this above the getExecutor interface. Internal flag set as a hint
+        // that the caller is a find, whose plan executor has no stages above the plan and only
+        // reads.
+        PRIVATE_IS_FIND = 1 << 12,
     };
 
     // See Options enum above.
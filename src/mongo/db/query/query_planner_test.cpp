@@ -1775,7 +1775,31 @@ TEST_F(QueryPlannerTest, TooManyToExplode) {
                               0,
                               1);
 
-    // We cap the # of ixscans we're willing to create.
+    // We cap the # of ixscans we're willing to create. Instead, the point prefixes are merged
+    // within a single scan.
+    assertNumSolutions(2);
+    assertSolutionExists(
+        "{sort: {pattern: {d: 1}, limit: 1, node: {sortKeyGen: "
+        "{node: {cscan: {dir: 1}}}}}}");
+    assertSolutionExists("{fetch: {node: {mergeIxscan: {pattern: {a: 1, b: 1, c:1, d:1}}}}}");
+}
+
+TEST_F(QueryPlannerTest, TooManyToMerge) {
+    addIndex(BSON("a" << 1 << "b" << 1 << "c" << 1 << "d" << 1));
+
+    // Allow one fewer interval than the 6 * 8 * 8 = 384 we need to merge.
+    int oldMaxIntervalsToMerge = internalQueryMaxIntervalsToMergeForSort;
+    internalQueryMaxIntervalsToMergeForSort = 383;
+
+    runQuerySortProjSkipLimit(fromjson(
+                                  "{a: {$in: [1,2,3,4,5,6]},"
+                                  "b:{$in:[1,2,3,4,5,6,7,8]},"
+                                  "c:{$in:[1,2,3,4,5,6,7,8]}}"),
+                              BSON("d" << 1),
+                              BSONObj(),
+                              0,
+                              1);
+
     assertNumSolutions(2);
     assertSolutionExists(
         "{sort: {pattern: {d: 1}, limit: 1, node: {sortKeyGen: "
@@ -1783,6 +1807,47 @@ TEST_F(QueryPlannerTest, TooManyToExplode) {
     assertSolutionExists(
         "{sort: {pattern: {d: 1}, limit: 1, node: {sortKeyGen: {node: "
         "{fetch: {node: {ixscan: {pattern: {a: 1, b: 1, c:1, d:1}}}}}}}}}");
+
+    internalQueryMaxIntervalsToMergeForSort = oldMaxIntervalsToMerge;
+}
+
+TEST_F(QueryPlannerTest, MergeIxscanReverse) {
+    addIndex(BSON("a" << 1 << "b" << 1));
+
+    // Force the point intervals to be merged rather than exploded.
+    int oldMaxScansToExplode = internalQueryMaxScansToExplode;
+    internalQueryMaxScansToExplode = 1;
+
+    runQuerySortProj(fromjson("{a: {$in: [1, 2, 3]}}"), BSON("b" << -1), BSONObj());
+
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{sort: {pattern: {b: -1}, limit: 0, node: {sortKeyGen: "
+        "{node: {cscan: {dir: 1}}}}}}");
+    assertSolutionExists(
+        "{fetch: {node: {mergeIxscan: {pattern: {a: 1, b: 1}, dir: -1, "
+        "bounds: {a: [[3,3,true,true],[2,2,true,true],[1,1,true,true]], "
+        "b: [['MaxKey','MinKey',true,true]]}}}}}");
+
+    internalQueryMaxScansToExplode = oldMaxScansToExplode;
+}
+
+TEST_F(QueryPlannerTest, MergeIxscanCoveredProjection) {
+    addIndex(BSON("a" << 1 << "b" << 1));
+
+    // Force the point intervals to be merged rather than exploded.
+    int oldMaxScansToExplode = internalQueryMaxScansToExplode;
+    internalQueryMaxScansToExplode = 1;
+
+    runQuerySortProj(
+        fromjson("{a: {$in: [1, 2, 3]}}"), BSON("b" << 1), fromjson("{_id: 0, a: 1, b: 1}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1, b: 1}, node: "
+        "{mergeIxscan: {pattern: {a: 1, b: 1}, dir: 1}}}}");
+
+    internalQueryMaxScansToExplode = oldMaxScansToExplode;
 }
 
 TEST_F(QueryPlannerTest, CantExplodeMetaSort) {
@@ -2947,6 +3012,81 @@ TEST_F(QueryPlannerTest, CompoundIndexBoundsIntersectRanges) {
         "c: [[1,10,false,false]]}}}}}");
 }
 
+//
+// Skip scan
+//
+
+TEST_F(QueryPlannerTest, SkipScanPredicateOverTrailingField) {
+    params.options |= QueryPlannerParams::SKIP_SCAN;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQuery(fromjson("{b: 5}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {filter: null, pattern: {a: 1, b: 1}, "
+        "bounds: {a: [['MinKey','MaxKey',true,true]], b: [[5,5,true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanCompoundsTrailingFields) {
+    params.options |= QueryPlannerParams::SKIP_SCAN;
+    addIndex(BSON("a" << 1 << "b" << 1 << "c" << 1));
+    runQuery(fromjson("{b: 5, c: {$gt: 3}}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {filter: null, pattern: {a: 1, b: 1, c: 1}, "
+        "bounds: {a: [['MinKey','MaxKey',true,true]], b: [[5,5,true,true]], "
+        "c: [[3,Infinity,false,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanUnderOr) {
+    params.options |= QueryPlannerParams::SKIP_SCAN;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    addIndex(BSON("c" << 1));
+    runQuery(fromjson("{$or: [{b: 5}, {c: 6}]}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {or: {nodes: ["
+        "{ixscan: {filter: null, pattern: {a: 1, b: 1}, "
+        "bounds: {a: [['MinKey','MaxKey',true,true]], b: [[5,5,true,true]]}}},"
+        "{ixscan: {filter: null, pattern: {c: 1}}}]}}}}");
+}
+
+// An index with a predicate over its leading field is not also skip scanned.
+TEST_F(QueryPlannerTest, SkipScanNotUsedWithLeadingFieldPredicate) {
+    params.options |= QueryPlannerParams::SKIP_SCAN;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQuery(fromjson("{a: {$gt: 1}, b: 5}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {filter: null, pattern: {a: 1, b: 1}, "
+        "bounds: {a: [[1,Infinity,false,true]], b: [[5,5,true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanRequiresOption) {
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQuery(fromjson("{b: 5}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanNotUsedForMultikeyIndex) {
+    params.options |= QueryPlannerParams::SKIP_SCAN;
+    const bool multikey = true;
+    addIndex(BSON("a" << 1 << "b" << 1), multikey);
+    runQuery(fromjson("{b: 5}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
 // Test that planner properly unionizes the index bounds for two negation
 // predicates (SERVER-13890).
 TEST_F(QueryPlannerTest, IndexBoundsOrOfNegations) {
@@ -3898,6 +4038,56 @@ TEST_F(QueryPlannerTest, CannotTrimIxisectAndHashWithOrChild) {
         "{ixscan: {filter: null, pattern: {c: 1}}}]}}}}");
 }
 
+TEST_F(QueryPlannerTest, CannotTrimIxisectAndBitmap) {
+    bool oldEnableBitmapIntersection = internalQueryPlannerEnableBitmapIntersection;
+    internalQueryPlannerEnableBitmapIntersection = true;
+
+    params.options = QueryPlannerParams::CANNOT_TRIM_IXISECT;
+    params.options |= QueryPlannerParams::INDEX_INTERSECTION;
+    params.options |= QueryPlannerParams::NO_TABLE_SCAN;
+
+    addIndex(BSON("a" << 1));
+    addIndex(BSON("b" << 1));
+
+    runQuery(fromjson("{a: {$gt: 1}, b: {$gt: 1}}"));
+
+    // The bitmap AND is used instead of the hash AND, with the whole predicate rechecked above.
+    assertNumSolutions(3U);
+    assertSolutionExists(
+        "{fetch: {filter: {b: {$gt: 1}}, node: "
+        "{ixscan: {filter: null, pattern: {a: 1}}}}}");
+    assertSolutionExists(
+        "{fetch: {filter: {a: {$gt: 1}}, node: "
+        "{ixscan: {filter: null, pattern: {b: 1}}}}}");
+    assertSolutionExists(
+        "{fetch: {filter: {a: {$gt: 1}, b: {$gt: 1}}, node: {andBitmap: {nodes: ["
+        "{ixscan: {filter: null, pattern: {a:1}}},"
+        "{ixscan: {filter: null, pattern: {b:1}}}]}}}}");
+
+    internalQueryPlannerEnableBitmapIntersection = oldEnableBitmapIntersection;
+}
+
+// The bitmap AND cannot be used unless the whole predicate is rechecked above it.
+TEST_F(QueryPlannerTest, AndBitmapRequiresCannotTrimIxisect) {
+    bool oldEnableBitmapIntersection = internalQueryPlannerEnableBitmapIntersection;
+    internalQueryPlannerEnableBitmapIntersection = true;
+
+    params.options = QueryPlannerParams::NO_TABLE_SCAN | QueryPlannerParams::INDEX_INTERSECTION;
+
+    addIndex(BSON("a" << 1));
+    addIndex(BSON("b" << 1));
+
+    runQuery(fromjson("{a: {$gt: 1}, b: {$gt: 1}}"));
+
+    assertNumSolutions(3U);
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {andHash: {nodes: ["
+        "{ixscan: {filter: null, pattern: {a:1}}},"
+        "{ixscan: {filter: null, pattern: {b:1}}}]}}}}");
+
+    internalQueryPlannerEnableBitmapIntersection = oldEnableBitmapIntersection;
+}
+
 TEST_F(QueryPlannerTest, CannotTrimIxisectParamSelfIntersection) {
     params.options = QueryPlannerParams::CANNOT_TRIM_IXISECT;
     params.options = QueryPlannerParams::INDEX_INTERSECTION;
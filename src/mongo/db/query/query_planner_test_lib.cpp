@@ -231,9 +231,11 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
             return false;
         }
         return filterMatches(filter.Obj(), trueSoln);
-    } else if (STAGE_IXSCAN == trueSoln->getType()) {
+    } else if (STAGE_IXSCAN == trueSoln->getType() ||
+               STAGE_MERGE_IXSCAN == trueSoln->getType()) {
         const IndexScanNode* ixn = static_cast<const IndexScanNode*>(trueSoln);
-        BSONElement el = testSoln["ixscan"];
+        BSONElement el =
+            testSoln[STAGE_IXSCAN == trueSoln->getType() ? "ixscan" : "mergeIxscan"];
         if (el.eoo() || !el.isABSONObj()) {
             return false;
         }
@@ -390,6 +392,13 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
         }
         BSONObj orObj = el.Obj();
         return childrenMatch(orObj, orn);
+    } else if (STAGE_AND_BITMAP == trueSoln->getType()) {
+        const AndBitmapNode* abn = static_cast<const AndBitmapNode*>(trueSoln);
+        BSONElement el = testSoln["andBitmap"];
+        if (el.eoo() || !el.isABSONObj()) {
+            return false;
+        }
+        return childrenMatch(el.Obj(), abn);
     } else if (STAGE_AND_HASH == trueSoln->getType()) {
         const AndHashNode* ahn = static_cast<const AndHashNode*>(trueSoln);
         BSONElement el = testSoln["andHash"];
@@ -132,6 +132,38 @@ QuerySolutionNode* CollectionScanNode::clone() const {
     return copy;
 }
 
+//
+// AndBitmapNode
+//
+
+AndBitmapNode::AndBitmapNode() {}
+
+AndBitmapNode::~AndBitmapNode() {}
+
+void AndBitmapNode::appendToString(mongoutils::str::stream* ss, int indent) const {
+    addIndent(ss, indent);
+    *ss << "AND_BITMAP\n";
+    if (NULL != filter) {
+        addIndent(ss, indent + 1);
+        *ss << " filter = " << filter->toString() << '\n';
+    }
+    addCommon(ss, indent);
+    for (size_t i = 0; i < children.size(); ++i) {
+        addIndent(ss, indent + 1);
+        *ss << "Child " << i << ":\n";
+        children[i]->appendToString(ss, indent + 1);
+    }
+}
+
+QuerySolutionNode* AndBitmapNode::clone() const {
+    AndBitmapNode* copy = new AndBitmapNode();
+    cloneBaseData(copy);
+
+    copy->_sort = this->_sort;
+
+    return copy;
+}
+
 //
 // AndHashNode
 //
@@ -613,6 +645,75 @@ bool IndexScanNode::operator==(const IndexScanNode& other) const {
         addKeyMetadata == other.addKeyMetadata && bounds == other.bounds;
 }
 
+//
+// MergeIndexScanNode
+//
+
+MergeIndexScanNode::MergeIndexScanNode() : numPointPrefixFields(0) {}
+
+void MergeIndexScanNode::appendToString(mongoutils::str::stream* ss, int indent) const {
+    addIndent(ss, indent);
+    *ss << "MERGE_IXSCAN\n";
+    addIndent(ss, indent + 1);
+    *ss << "keyPattern = " << indexKeyPattern << '\n';
+    if (NULL != filter) {
+        addIndent(ss, indent + 1);
+        *ss << "filter = " << filter->toString();
+    }
+    addIndent(ss, indent + 1);
+    *ss << "direction = " << direction << '\n';
+    addIndent(ss, indent + 1);
+    *ss << "numPointPrefixFields = " << numPointPrefixFields << '\n';
+    addIndent(ss, indent + 1);
+    *ss << "bounds = " << bounds.toString() << '\n';
+    addCommon(ss, indent);
+}
+
+void MergeIndexScanNode::computeProperties() {
+    _sorts.clear();
+
+    // The merged output is sorted by the fields following the point prefix, and by every prefix
+    // of those fields.
+    BSONObj sortPattern = QueryPlannerAnalysis::getSortPattern(indexKeyPattern);
+    if (direction == -1) {
+        sortPattern = QueryPlannerCommon::reverseSortObj(sortPattern);
+    }
+
+    std::vector<BSONElement> suffix;
+    BSONObjIterator it(sortPattern);
+    for (size_t i = 0; it.more(); ++i) {
+        BSONElement elt = it.next();
+        if (i >= numPointPrefixFields) {
+            suffix.push_back(elt);
+        }
+    }
+
+    for (size_t i = 0; i < suffix.size(); ++i) {
+        // Make obj out of suffix fields [0,i]
+        BSONObjBuilder prefixBob;
+        for (size_t j = 0; j <= i; ++j) {
+            prefixBob.append(suffix[j]);
+        }
+        _sorts.insert(prefixBob.obj());
+    }
+}
+
+QuerySolutionNode* MergeIndexScanNode::clone() const {
+    MergeIndexScanNode* copy = new MergeIndexScanNode();
+    cloneBaseData(copy);
+
+    copy->_sorts = this->_sorts;
+    copy->indexKeyPattern = this->indexKeyPattern;
+    copy->indexIsMultiKey = this->indexIsMultiKey;
+    copy->direction = this->direction;
+    copy->maxScan = this->maxScan;
+    copy->addKeyMetadata = this->addKeyMetadata;
+    copy->bounds = this->bounds;
+    copy->numPointPrefixFields = this->numPointPrefixFields;
+
+    return copy;
+}
+
 //
 // ProjectionNode
 //
@@ -292,6 +292,35 @@ struct CollectionScanNode : public QuerySolutionNode {
     int maxScan;
 };
 
+struct AndBitmapNode : public QuerySolutionNode {
+    AndBitmapNode();
+    virtual ~AndBitmapNode();
+
+    virtual StageType getType() const {
+        return STAGE_AND_BITMAP;
+    }
+
+    virtual void appendToString(mongoutils::str::stream* ss, int indent) const;
+
+    // The stage fetches the documents which survive the intersection itself.
+    bool fetched() const {
+        return true;
+    }
+    bool hasField(const std::string& field) const {
+        return true;
+    }
+    bool sortedByDiskLoc() const {
+        return true;
+    }
+    const BSONObjSet& getSort() const {
+        return _sort;
+    }
+
+    QuerySolutionNode* clone() const;
+
+    BSONObjSet _sort;
+};
+
 struct AndHashNode : public QuerySolutionNode {
     AndHashNode();
     virtual ~AndHashNode();
@@ -477,6 +506,32 @@ struct IndexScanNode : public QuerySolutionNode {
     IndexBounds bounds;
 };
 
+/**
+ * An index scan whose first 'numPointPrefixFields' fields are bounded by unions of point
+ * intervals. The results of each combination of the prefix points are merged, so the output is
+ * sorted by the remaining fields of the index key pattern.
+ */
+struct MergeIndexScanNode : public IndexScanNode {
+    MergeIndexScanNode();
+    virtual ~MergeIndexScanNode() {}
+
+    virtual void computeProperties();
+
+    virtual StageType getType() const {
+        return STAGE_MERGE_IXSCAN;
+    }
+
+    virtual void appendToString(mongoutils::str::stream* ss, int indent) const;
+
+    bool sortedByDiskLoc() const {
+        return false;
+    }
+
+    QuerySolutionNode* clone() const;
+
+    size_t numPointPrefixFields;
+};
+
 struct ProjectionNode : public QuerySolutionNode {
     /**
      * We have a few implementations of the projection functionality.  The most general
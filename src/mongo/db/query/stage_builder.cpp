@@ -33,6 +33,7 @@
 #include "mongo/db/query/stage_builder.h"
 
 #include "mongo/db/client.h"
+#include "mongo/db/exec/and_bitmap.h"
 #include "mongo/db/exec/and_hash.h"
 #include "mongo/db/exec/and_sorted.h"
 #include "mongo/db/exec/collection_scan.h"
@@ -44,6 +45,7 @@
 #include "mongo/db/exec/index_scan.h"
 #include "mongo/db/exec/keep_mutations.h"
 #include "mongo/db/exec/limit.h"
+#include "mongo/db/exec/merge_index_scan.h"
 #include "mongo/db/exec/merge_sort.h"
 #include "mongo/db/exec/or.h"
 #include "mongo/db/exec/projection.h"
@@ -102,6 +104,30 @@ PlanStage* buildStages(OperationContext* txn,
         params.maxScan = ixn->maxScan;
         params.addKeyMetadata = ixn->addKeyMetadata;
         return new IndexScan(txn, params, ws, ixn->filter.get());
+    } else if (STAGE_MERGE_IXSCAN == root->getType()) {
+        const MergeIndexScanNode* mixn = static_cast<const MergeIndexScanNode*>(root);
+
+        if (NULL == collection) {
+            warning() << "Can't ixscan null namespace";
+            return NULL;
+        }
+
+        IndexScanParams params;
+
+        params.descriptor =
+            collection->getIndexCatalog()->findIndexByKeyPattern(txn, mixn->indexKeyPattern);
+        if (params.descriptor == NULL) {
+            warning() << "Can't find index " << mixn->indexKeyPattern.toString()
+                      << "in namespace " << collection->ns() << endl;
+            return NULL;
+        }
+
+        params.bounds = mixn->bounds;
+        params.direction = mixn->direction;
+        params.maxScan = mixn->maxScan;
+        params.addKeyMetadata = mixn->addKeyMetadata;
+        return new MergeIndexScan(
+            txn, params, mixn->numPointPrefixFields, ws, mixn->filter.get());
     } else if (STAGE_FETCH == root->getType()) {
         const FetchNode* fn = static_cast<const FetchNode*>(root);
         PlanStage* childStage = buildStages(txn, collection, qsol, fn->children[0], ws);
@@ -166,6 +192,17 @@ PlanStage* buildStages(OperationContext* txn,
             return NULL;
         }
         return new SkipStage(txn, sn->skip, ws, childStage);
+    } else if (STAGE_AND_BITMAP == root->getType()) {
+        const AndBitmapNode* abn = static_cast<const AndBitmapNode*>(root);
+        auto ret = make_unique<AndBitmapStage>(txn, ws, collection);
+        for (size_t i = 0; i < abn->children.size(); ++i) {
+            PlanStage* childStage = buildStages(txn, collection, qsol, abn->children[i], ws);
+            if (NULL == childStage) {
+                return NULL;
+            }
+            ret->addChild(childStage);
+        }
+        return ret.release();
     } else if (STAGE_AND_HASH == root->getType()) {
         const AndHashNode* ahn = static_cast<const AndHashNode*>(root);
         auto ret = make_unique<AndHashStage>(txn, ws, collection);
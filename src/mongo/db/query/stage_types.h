@@ -34,6 +34,10 @@ namespace mongo {
  * These map to implementations of the PlanStage interface, all of which live in db/exec/
  */
 enum StageType {
+    // Intersects the RecordIds of its children using compressed bitmaps, then fetches the
+    // surviving documents.
+    STAGE_AND_BITMAP,
+
     STAGE_AND_HASH,
     STAGE_AND_SORTED,
     STAGE_CACHED_PLAN,
@@ -81,6 +85,10 @@ enum StageType {
     STAGE_IXSCAN,
     STAGE_LIMIT,
 
+    // An index scan over many point prefixes which merges their results to provide a sort on
+    // the remaining fields of the index.
+    STAGE_MERGE_IXSCAN,
+
     // Implements parallelCollectionScan.
     STAGE_MULTI_ITERATOR,
 
@@ -206,6 +206,13 @@ public:
         return _chunksMap.size();
     }
 
+    /**
+     * Returns the chunks owned by this shard, with contiguous chunks merged into a single range.
+     */
+    const RangeMap& getOwnedRanges() const {
+        return _rangesMap;
+    }
+
     std::size_t getNumPending() const {
         return _pendingMap.size();
     }
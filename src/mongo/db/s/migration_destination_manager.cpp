@@ -43,6 +43,7 @@
 #include "mongo/db/catalog/document_validation.h"
 #include "mongo/db/catalog/index_create.h"
 #include "mongo/db/client.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbhelpers.h"
@@ -132,6 +133,80 @@ bool willOverrideLocalId(OperationContext* txn,
     return false;
 }
 
+/**
+ * Applies a batch of documents received from the donor shard under a single write lock. Documents
+ * whose _id is not present locally are inserted through one Collection::insertDocuments call in a
+ * single WriteUnitOfWork; the others, and the whole batch if the grouped insert hits a duplicate
+ * key, are upserted one at a time. Throws with 'errCode' if a document would override a local
+ * document with the same _id which belongs to a different range.
+ */
+void applyDocuments(OperationContext* txn,
+                    const string& ns,
+                    const BSONObj& min,
+                    const BSONObj& max,
+                    const BSONObj& shardKeyPattern,
+                    const std::vector<BSONObj>& docs,
+                    int errCode,
+                    StringData docDescription) {
+    OldClientWriteContext cx(txn, ns);
+
+    std::vector<BSONObj> toInsert;
+    std::vector<BSONObj> toUpsert;
+
+    for (const BSONObj& doc : docs) {
+        BSONObj localDoc;
+        if (willOverrideLocalId(txn, ns, min, max, shardKeyPattern, cx.db(), doc, &localDoc)) {
+            string errMsg = str::stream() << "cannot migrate chunk, local document " << localDoc
+                                          << " has same _id as " << docDescription << " " << doc;
+
+            warning() << errMsg;
+
+            // Exception will abort migration cleanly
+            uasserted(errCode, errMsg);
+        }
+
+        if (localDoc.isEmpty()) {
+            toInsert.push_back(doc);
+        } else {
+            toUpsert.push_back(doc);
+        }
+    }
+
+    // Without an _id index a duplicate within the batch would not be detected, so only group the
+    // inserts when there is one.
+    Collection* const collection = cx.getCollection();
+    if (collection && !toInsert.empty() && collection->getIndexCatalog()->findIdIndex(txn)) {
+        bool insertedAll = false;
+
+        MONGO_WRITE_CONFLICT_RETRY_LOOP_BEGIN {
+            WriteUnitOfWork wuow(txn);
+            Status status = collection->insertDocuments(txn,
+                                                        toInsert.begin(),
+                                                        toInsert.end(),
+                                                        true /* enforceQuota */,
+                                                        true /* fromMigrate */);
+            if (status.isOK()) {
+                wuow.commit();
+                insertedAll = true;
+            } else if (status.code() != ErrorCodes::DuplicateKey) {
+                uassertStatusOK(status);
+            }
+        }
+        MONGO_WRITE_CONFLICT_RETRY_LOOP_END(txn, "migrateApplyDocuments", ns);
+
+        if (insertedAll) {
+            toInsert.clear();
+        }
+    }
+
+    // We are in write lock here, so sure we aren't killing
+    for (const auto& batch : {&toInsert, &toUpsert}) {
+        for (const BSONObj& doc : *batch) {
+            Helpers::upsert(txn, ns, doc, true);
+        }
+    }
+}
+
 /**
  * Returns true if the majority of the nodes and the nodes corresponding to the given writeConcern
  * (if not empty) have applied till the specified lastOp.
@@ -620,11 +695,18 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* txn,
                 return;
             }
 
-            BSONObj arr = res["objects"].Obj();
-            int thisTime = 0;
+            std::vector<BSONObj> docsToClone;
+            long long clonedBytes = 0;
 
-            BSONObjIterator i(arr);
+            BSONObjIterator i(res["objects"].Obj());
             while (i.more()) {
+                BSONObj docToClone = i.next().Obj();
+                clonedBytes += docToClone.objsize();
+                docsToClone.push_back(docToClone);
+            }
+
+            const int thisTime = docsToClone.size();
+            if (thisTime > 0) {
                 txn->checkForInterrupt();
 
                 if (getState() == ABORT) {
@@ -634,31 +716,19 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* txn,
                     return;
                 }
 
-                BSONObj docToClone = i.next().Obj();
-                {
-                    OldClientWriteContext cx(txn, ns);
-
-                    BSONObj localDoc;
-                    if (willOverrideLocalId(
-                            txn, ns, min, max, shardKeyPattern, cx.db(), docToClone, &localDoc)) {
-                        string errMsg = str::stream() << "cannot migrate chunk, local document "
-                                                      << localDoc << " has same _id as cloned "
-                                                      << "remote document " << docToClone;
-
-                        warning() << errMsg;
-
-                        // Exception will abort migration cleanly
-                        uasserted(16976, errMsg);
-                    }
-
-                    Helpers::upsert(txn, ns, docToClone, true);
-                }
-                thisTime++;
+                applyDocuments(txn,
+                               ns,
+                               min,
+                               max,
+                               shardKeyPattern,
+                               docsToClone,
+                               16976,
+                               "cloned remote document");
 
                 {
                     stdx::lock_guard<stdx::mutex> statsLock(_mutex);
-                    _numCloned++;
-                    _clonedBytes += docToClone.objsize();
+                    _numCloned += thisTime;
+                    _clonedBytes += clonedBytes;
                 }
 
                 if (writeConcern.shouldWaitForOtherNodes()) {
@@ -899,10 +969,10 @@ bool MigrationDestinationManager::_applyMigrateOp(OperationContext* txn,
     }
 
     if (xfer["reload"].isABSONObj()) {  // modified documents (insert/update)
+        std::vector<BSONObj> updatedDocs;
+
         BSONObjIterator i(xfer["reload"].Obj());
         while (i.more()) {
-            OldClientWriteContext cx(txn, ns);
-
             BSONObj updatedDoc = i.next().Obj();
 
             // do not apply insert/update if doc does not belong to the chunk being migrated
@@ -913,21 +983,18 @@ bool MigrationDestinationManager::_applyMigrateOp(OperationContext* txn,
                 continue;
             }
 
-            BSONObj localDoc;
-            if (willOverrideLocalId(
-                    txn, ns, min, max, shardKeyPattern, cx.db(), updatedDoc, &localDoc)) {
-                string errMsg = str::stream() << "cannot migrate chunk, local document " << localDoc
-                                              << " has same _id as reloaded remote document "
-                                              << updatedDoc;
-
-                warning() << errMsg;
-
-                // Exception will abort migration cleanly
-                uasserted(16977, errMsg);
-            }
+            updatedDocs.push_back(updatedDoc);
+        }
 
-            // We are in write lock here, so sure we aren't killing
-            Helpers::upsert(txn, ns, updatedDoc, true);
+        if (!updatedDocs.empty()) {
+            applyDocuments(txn,
+                           ns,
+                           min,
+                           max,
+                           shardKeyPattern,
+                           updatedDocs,
+                           16977,
+                           "reloaded remote document");
 
             *lastOpApplied = repl::ReplClientInfo::forClient(txn->getClient()).getLastOp();
             didAnything = true;
@@ -542,29 +542,34 @@ bool MigrationSourceManager::clone(OperationContext* txn,
 
         stdx::lock_guard<stdx::mutex> lk(_cloneLocsMutex);
 
+        // _cloneLocs is ordered by RecordId, so fetch the documents through a single record cursor
+        // rather than looking each one up from scratch.
+        auto cursor = collection->getCursor(txn);
+
         std::set<RecordId>::iterator cloneLocsIter = _cloneLocs.begin();
         for (; cloneLocsIter != _cloneLocs.end(); ++cloneLocsIter) {
             if (tracker.intervalHasElapsed())  // should I yield?
                 break;
 
             RecordId recordId = *cloneLocsIter;
-            Snapshotted<BSONObj> doc;
-            if (!collection->findDoc(txn, recordId, &doc)) {
+            boost::optional<Record> record = cursor->seekExact(recordId);
+            if (!record) {
                 // doc was deleted
                 continue;
             }
 
+            const BSONObj doc = record->data.toBson();
+
             // Use the builder size instead of accumulating 'doc's size so that we take
             // into consideration the overhead of BSONArray indices, and *always*
             // append one doc.
             if (clonedDocsArrayBuilder.arrSize() != 0 &&
-                (clonedDocsArrayBuilder.len() + doc.value().objsize() + 1024) >
-                    BSONObjMaxUserSize) {
+                (clonedDocsArrayBuilder.len() + doc.objsize() + 1024) > BSONObjMaxUserSize) {
                 isBufferFilled = true;  // break out of outer while loop
                 break;
             }
 
-            clonedDocsArrayBuilder.append(doc.value());
+            clonedDocsArrayBuilder.append(doc);
         }
 
         _cloneLocs.erase(_cloneLocs.begin(), cloneLocsIter);
@@ -28,6 +28,7 @@
 
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/db/commands/server_status.h"
+#include "mongo/db/dbhelpers.h"
 #include "mongo/db/range_deleter_service.h"
 
 namespace mongo {
@@ -48,7 +49,14 @@ namespace mongo {
  *       waitForReplStart: ISODate("2014-06-11T22:45:30.221Z"),
  *       waitForReplEnd: ISODate("2014-06-11T22:45:30.221Z")
  *     }
- *   ]
+ *   ],
+ *   progress: {
+ *     activeRemovals: NumberLong(1),
+ *     batches: NumberLong(40),
+ *     deletedDocs: NumberLong(5120),
+ *     waitForReplMillis: NumberLong(350),
+ *     throttledMillis: NumberLong(780)
+ *   }
  * }
  */
 class RangeDeleterServerStatusSection : public ServerStatusSection {
@@ -94,6 +102,15 @@ public:
         }
         result.append("lastDeleteStats", oldStatsBuilder.arr());
 
+        const Helpers::RemoveRangeProgress& progress = Helpers::removeRangeProgress;
+        BSONObjBuilder progressBuilder(result.subobjStart("progress"));
+        progressBuilder.append("activeRemovals", progress.activeRemovals.load());
+        progressBuilder.append("batches", progress.batches.load());
+        progressBuilder.append("deletedDocs", progress.deletedDocs.load());
+        progressBuilder.append("waitForReplMillis", progress.waitForReplMillis.load());
+        progressBuilder.append("throttledMillis", progress.throttledMillis.load());
+        progressBuilder.doneFast();
+
         return result.obj();
     }
 
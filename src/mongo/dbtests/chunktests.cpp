@@ -62,6 +62,7 @@ public:
         }
 
         _chunkRanges.reloadAll(_chunkMap);
+        _loadRoutingTable();
     }
 };
 
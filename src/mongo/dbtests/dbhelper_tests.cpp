@@ -105,11 +105,59 @@ private:
     int _max;
 };
 
+/** Helpers::removeRange deletes the whole range when it spans several batches. */
+class RemoveRangeInBatches {
+public:
+    void run() {
+        const int oldBatchSize = rangeDeleterBatchSize.load();
+        const int oldBatchDelayMS = rangeDeleterBatchDelayMS.load();
+        rangeDeleterBatchSize.store(3);
+        rangeDeleterBatchDelayMS.store(0);
+
+        OperationContextImpl txn;
+        DBDirectClient client(&txn);
+        client.dropCollection(ns);
+
+        for (int i = 0; i < 100; ++i) {
+            client.insert(ns, BSON("_id" << i));
+        }
+
+        const long long batchesBefore = Helpers::removeRangeProgress.batches.load();
+        const long long deletedBefore = Helpers::removeRangeProgress.deletedDocs.load();
+
+        long long numDeleted;
+        {
+            // Remove _id range [10, 90).
+            ScopedTransaction transaction(&txn, MODE_IX);
+            Lock::DBLock lk(txn.lockState(), nsToDatabaseSubstring(ns), MODE_X);
+            OldClientContext ctx(&txn, ns);
+
+            KeyRange range(ns, BSON("_id" << 10), BSON("_id" << 90), BSON("_id" << 1));
+            mongo::WriteConcernOptions dummyWriteConcern;
+            numDeleted = Helpers::removeRange(&txn, range, false, dummyWriteConcern);
+        }
+
+        ASSERT_EQUALS(80, numDeleted);
+        ASSERT_EQUALS(20U, client.count(ns));
+        ASSERT_EQUALS(0U, client.count(ns, BSON("_id" << GTE << 10 << LT << 90)));
+
+        // 80 documents in batches of 3.
+        ASSERT_EQUALS(27, Helpers::removeRangeProgress.batches.load() - batchesBefore);
+        ASSERT_EQUALS(80, Helpers::removeRangeProgress.deletedDocs.load() - deletedBefore);
+        ASSERT_EQUALS(0, Helpers::removeRangeProgress.activeRemovals.load());
+
+        client.dropCollection(ns);
+        rangeDeleterBatchSize.store(oldBatchSize);
+        rangeDeleterBatchDelayMS.store(oldBatchDelayMS);
+    }
+};
+
 class All : public Suite {
 public:
     All() : Suite("remove") {}
     void setupTests() {
         add<RemoveRange>();
+        add<RemoveRangeInBatches>();
     }
 } myall;
 
@@ -44,9 +44,11 @@
 #include <boost/thread/thread.hpp>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <mutex>
 
 #include "mongo/config.h"
+#include "mongo/db/catalog/cursor_manager.h"
 #include "mongo/db/client.h"
 #include "mongo/db/db.h"
 #include "mongo/db/dbdirectclient.h"
@@ -57,6 +59,8 @@
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/dbtests/framework_options.h"
+#include "mongo/platform/random.h"
+#include "mongo/s/chunk_routing_table.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/util/log.h"
@@ -444,6 +448,109 @@ public:
     }
 };
 
+/**
+ * Registers and deregisters an executor with a collection's CursorManager, as every find,
+ * getMore and aggregation does. The threaded run measures contention between readers of the
+ * same collection.
+ */
+class cursormanagerregistration : public B {
+public:
+    cursormanagerregistration() : _cursorManager("perftest.cursormanagerregistration") {}
+    string name() {
+        return "CursorManager::registerExecutor";
+    }
+    virtual int howLongMillis() {
+        return 500;
+    }
+    virtual bool showDurStats() {
+        return false;
+    }
+    virtual bool testThreaded() {
+        return true;
+    }
+    void timed() {
+        registerAndDeregister();
+    }
+    void timed2(DBClientBase*) {
+        registerAndDeregister();
+    }
+
+private:
+    void registerAndDeregister() {
+        // The executor is never dereferenced, so any heap address will do. Like real executors,
+        // concurrent callers get distinct heap addresses.
+        std::unique_ptr<char> marker(new char(0));
+        PlanExecutor* exec = reinterpret_cast<PlanExecutor*>(marker.get());
+        _cursorManager.registerExecutor(exec);
+        _cursorManager.deregisterExecutor(exec);
+    }
+
+    CursorManager _cursorManager;
+};
+
+/**
+ * Finds the chunk owning a shard key among 100,000 chunks, as mongos does to target a write or an
+ * equality query. chunkmapupperbound does the same lookup in the BSONObj-keyed ChunkMap, for
+ * comparison.
+ */
+class ChunkTargetingBase : public B {
+public:
+    ChunkTargetingBase() : _random(1) {
+        for (int i = 1; i < kNumChunks; ++i) {
+            _maxKeys.push_back(BSON("a" << i * 10));
+        }
+        _maxKeys.push_back(BSON("a" << MAXKEY));
+    }
+    virtual int howLongMillis() {
+        return 500;
+    }
+    virtual bool showDurStats() {
+        return false;
+    }
+
+protected:
+    BSONObj nextKey() {
+        return BSON("a" << _random.nextInt32(kNumChunks * 10));
+    }
+
+    static const int kNumChunks = 100000;
+    PseudoRandom _random;
+    vector<BSONObj> _maxKeys;
+};
+
+class chunkroutingtableupperbound : public ChunkTargetingBase {
+public:
+    chunkroutingtableupperbound() : _table(_maxKeys) {}
+    string name() {
+        return "ChunkRoutingTable::upperBound";
+    }
+    void timed() {
+        _found += _table.upperBound(nextKey());
+    }
+
+private:
+    ChunkRoutingTable _table;
+    size_t _found = 0;
+};
+
+class chunkmapupperbound : public ChunkTargetingBase {
+public:
+    chunkmapupperbound() {
+        for (const auto& maxKey : _maxKeys) {
+            _map[maxKey] = std::make_shared<int>(0);
+        }
+    }
+    string name() {
+        return "ChunkMap::upper_bound";
+    }
+    void timed() {
+        _found += *_map.upper_bound(nextKey())->second;
+    }
+
+private:
+    std::map<BSONObj, std::shared_ptr<int>, BSONObjCmp> _map;
+    int _found = 0;
+};
 
 class All : public Suite {
 public:
@@ -457,6 +564,9 @@ public:
         add<boosttimed_mutexspeed>();
         add<stdmutexspeed>();
         add<stdtimed_mutexspeed>();
+        add<cursormanagerregistration>();
+        add<chunkroutingtableupperbound>();
+        add<chunkmapupperbound>();
     }
 } myall;
 }
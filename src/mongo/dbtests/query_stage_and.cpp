@@ -37,6 +37,7 @@
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbdirectclient.h"
+#include "mongo/db/exec/and_bitmap.h"
 #include "mongo/db/exec/and_hash.h"
 #include "mongo/db/exec/and_sorted.h"
 #include "mongo/db/exec/fetch.h"
@@ -1442,6 +1443,217 @@ public:
 };
 
 
+//
+// Bitmap AND tests
+//
+
+/**
+ * Intersect two index scans with a bitmap AND. The results should be fetched and returned in
+ * RecordId order.
+ */
+class QueryStageAndBitmapTwoLeaf : public QueryStageAndBase {
+public:
+    void run() {
+        OldClientWriteContext ctx(&_txn, ns());
+        Database* db = ctx.db();
+        Collection* coll = ctx.getCollection();
+        if (!coll) {
+            WriteUnitOfWork wuow(&_txn);
+            coll = db->createCollection(&_txn, ns());
+            wuow.commit();
+        }
+
+        for (int i = 0; i < 50; ++i) {
+            insert(BSON("foo" << i << "bar" << i));
+        }
+
+        addIndex(BSON("foo" << 1));
+        addIndex(BSON("bar" << 1));
+
+        WorkingSet ws;
+        auto ab = make_unique<AndBitmapStage>(&_txn, &ws, coll);
+
+        // Foo <= 20
+        IndexScanParams params;
+        params.descriptor = getIndex(BSON("foo" << 1), coll);
+        params.bounds.isSimpleRange = true;
+        params.bounds.startKey = BSON("" << 20);
+        params.bounds.endKey = BSONObj();
+        params.bounds.endKeyInclusive = true;
+        params.direction = -1;
+        ab->addChild(new IndexScan(&_txn, params, &ws, NULL));
+
+        // Bar >= 10
+        params.descriptor = getIndex(BSON("bar" << 1), coll);
+        params.bounds.startKey = BSON("" << 10);
+        params.bounds.endKey = BSONObj();
+        params.bounds.endKeyInclusive = true;
+        params.direction = 1;
+        ab->addChild(new IndexScan(&_txn, params, &ws, NULL));
+
+        // foo == bar, and foo<=20, bar>=10, so our values are:
+        // foo == 10, 11, 12, 13, 14, 15. 16, 17, 18, 19, 20
+        int count = 0;
+        RecordId lastRecordId;
+        while (!ab->isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            PlanStage::StageState status = ab->work(&id);
+            if (PlanStage::ADVANCED != status) {
+                continue;
+            }
+
+            ++count;
+            WorkingSetMember* member = ws.get(id);
+            ASSERT_EQUALS(WorkingSetMember::RID_AND_OBJ, member->getState());
+            ASSERT_LESS_THAN(lastRecordId, member->recordId);
+            lastRecordId = member->recordId;
+
+            BSONElement elt;
+            ASSERT_TRUE(member->getFieldDotted("foo", &elt));
+            ASSERT_LESS_THAN_OR_EQUALS(elt.numberInt(), 20);
+            ASSERT_GREATER_THAN_OR_EQUALS(elt.numberInt(), 10);
+        }
+
+        ASSERT_EQUALS(11, count);
+
+        const AndBitmapStats* stats = static_cast<const AndBitmapStats*>(ab->getSpecificStats());
+        ASSERT_EQUALS(2U, stats->intersectionAfterChild.size());
+        ASSERT_EQUALS(21U, stats->intersectionAfterChild[0]);
+        ASSERT_EQUALS(11U, stats->intersectionAfterChild[1]);
+        ASSERT_EQUALS(11U, stats->docsFetched);
+    }
+};
+
+/**
+ * Invalidate a RecordId held by a bitmap AND before the AND finishes evaluating. The deleted
+ * document should not be returned.
+ */
+class QueryStageAndBitmapInvalidation : public QueryStageAndBase {
+public:
+    void run() {
+        OldClientWriteContext ctx(&_txn, ns());
+        Database* db = ctx.db();
+        Collection* coll = ctx.getCollection();
+        if (!coll) {
+            WriteUnitOfWork wuow(&_txn);
+            coll = db->createCollection(&_txn, ns());
+            wuow.commit();
+        }
+
+        for (int i = 0; i < 50; ++i) {
+            insert(BSON("foo" << i << "bar" << i));
+        }
+
+        addIndex(BSON("foo" << 1));
+        addIndex(BSON("bar" << 1));
+
+        WorkingSet ws;
+        auto ab = make_unique<AndBitmapStage>(&_txn, &ws, coll);
+
+        // Foo <= 20
+        IndexScanParams params;
+        params.descriptor = getIndex(BSON("foo" << 1), coll);
+        params.bounds.isSimpleRange = true;
+        params.bounds.startKey = BSON("" << 20);
+        params.bounds.endKey = BSONObj();
+        params.bounds.endKeyInclusive = true;
+        params.direction = -1;
+        ab->addChild(new IndexScan(&_txn, params, &ws, NULL));
+
+        // Bar >= 10
+        params.descriptor = getIndex(BSON("bar" << 1), coll);
+        params.bounds.startKey = BSON("" << 10);
+        params.bounds.endKey = BSONObj();
+        params.bounds.endKeyInclusive = true;
+        params.direction = 1;
+        ab->addChild(new IndexScan(&_txn, params, &ws, NULL));
+
+        // ab reads foo=20, foo=19, ..., foo=0 from the first child. Read half of them...
+        for (int i = 0; i < 10; ++i) {
+            WorkingSetID out;
+            PlanStage::StageState status = ab->work(&out);
+            ASSERT_EQUALS(PlanStage::NEED_TIME, status);
+        }
+
+        // ...yield
+        ab->saveState();
+        // ...invalidate one of the read objects
+        set<RecordId> data;
+        getRecordIds(&data, coll);
+        for (set<RecordId>::const_iterator it = data.begin(); it != data.end(); ++it) {
+            if (coll->docFor(&_txn, *it).value()["foo"].numberInt() == 15) {
+                ab->invalidate(&_txn, *it, INVALIDATION_DELETION);
+                remove(coll->docFor(&_txn, *it).value());
+                break;
+            }
+        }
+        ab->restoreState();
+
+        // Nothing is flagged: the bitmap AND simply forgets about the deleted RecordId.
+        ASSERT_EQUALS(size_t(0), ws.getFlagged().size());
+
+        // Since foo == bar, we would have 11 results, but we subtract one because of a mid-plan
+        // invalidation, so 10.
+        int count = 0;
+        while (!ab->isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            PlanStage::StageState status = ab->work(&id);
+            if (PlanStage::ADVANCED != status) {
+                continue;
+            }
+
+            ++count;
+            WorkingSetMember* member = ws.get(id);
+
+            BSONElement elt;
+            ASSERT_TRUE(member->getFieldDotted("foo", &elt));
+            ASSERT_NOT_EQUALS(15, elt.numberInt());
+        }
+
+        ASSERT_EQUALS(10, count);
+    }
+};
+
+// A bitmap AND fails once its bitmaps exceed the memory limit.
+class QueryStageAndBitmapExceedsMemLimit : public QueryStageAndBase {
+public:
+    void run() {
+        OldClientWriteContext ctx(&_txn, ns());
+        Database* db = ctx.db();
+        Collection* coll = ctx.getCollection();
+        if (!coll) {
+            WriteUnitOfWork wuow(&_txn);
+            coll = db->createCollection(&_txn, ns());
+            wuow.commit();
+        }
+
+        for (int i = 0; i < 50; ++i) {
+            insert(BSON("foo" << i << "bar" << i));
+        }
+
+        addIndex(BSON("foo" << 1));
+        addIndex(BSON("bar" << 1));
+
+        WorkingSet ws;
+        // A single RecordId uses more than one byte.
+        auto ab = make_unique<AndBitmapStage>(&_txn, &ws, coll, 1);
+
+        IndexScanParams params;
+        params.descriptor = getIndex(BSON("foo" << 1), coll);
+        params.bounds.isSimpleRange = true;
+        params.bounds.startKey = BSON("" << 0);
+        params.bounds.endKey = BSONObj();
+        params.bounds.endKeyInclusive = true;
+        params.direction = 1;
+        ab->addChild(new IndexScan(&_txn, params, &ws, NULL));
+
+        params.descriptor = getIndex(BSON("bar" << 1), coll);
+        ab->addChild(new IndexScan(&_txn, params, &ws, NULL));
+
+        ASSERT_EQUALS(-1, countResults(ab.get()));
+    }
+};
+
 class All : public Suite {
 public:
     All() : Suite("query_stage_and") {}
@@ -1466,6 +1678,9 @@ public:
         add<QueryStageAndSortedByLastChild>();
         add<QueryStageAndSortedFirstChildFetched>();
         add<QueryStageAndSortedSecondChildFetched>();
+        add<QueryStageAndBitmapTwoLeaf>();
+        add<QueryStageAndBitmapInvalidation>();
+        add<QueryStageAndBitmapExceedsMemLimit>();
     }
 };
 
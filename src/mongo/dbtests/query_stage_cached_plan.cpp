@@ -43,8 +43,12 @@
 #include "mongo/db/query/plan_yield_policy.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner_params.h"
+#include "mongo/db/service_context.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/util/fail_point_registry.h"
+#include "mongo/util/fail_point_service.h"
+#include "mongo/util/scopeguard.h"
 
 namespace QueryStageCachedPlan {
 
@@ -235,6 +239,171 @@ public:
     }
 };
 
+/**
+ * Runs a cached plan which stops producing results after its trial period, with mid-query
+ * replanning enabled, and checks that each result is returned exactly once. The cached plan is
+ * the root of a PlanExecutor, which replans between calls to work() under 'yieldPolicy'.
+ */
+class QueryStageCachedPlanMidQueryReplanBase : public QueryStageCachedPlanBase {
+protected:
+    void runStalledCachedPlan(size_t plannerOptions,
+                              PlanExecutor::YieldPolicy yieldPolicy,
+                              bool expectReplan) {
+        // Mid-query replanning is only enabled on storage engines with document-level locking.
+        if (!supportsDocLocking()) {
+            return;
+        }
+
+        const bool oldEnableMidQueryReplanning = internalQueryCacheEnableMidQueryReplanning.load();
+        internalQueryCacheEnableMidQueryReplanning.store(true);
+
+        // End the trial period as soon as the cached plan produces a single result.
+        const int oldMaxResults = internalQueryPlanEvaluationMaxResults.load();
+        internalQueryPlanEvaluationMaxResults.store(1);
+
+        AutoGetCollectionForRead ctx(&_txn, nss.ns());
+        Collection* collection = ctx.getCollection();
+        ASSERT(collection);
+
+        // Query can be answered by either index on "a" or index on "b".
+        auto statusWithCQ = CanonicalQuery::canonicalize(
+            nss, fromjson("{a: {$gte: 8}, b: 1}"), ExtensionsCallbackDisallowExtensions());
+        ASSERT_OK(statusWithCQ.getStatus());
+        const std::unique_ptr<CanonicalQuery> cq = std::move(statusWithCQ.getValue());
+
+        PlanCache* cache = collection->infoCache()->getPlanCache();
+        ASSERT(cache);
+        CachedSolution* rawCachedSolution;
+        ASSERT_NOT_OK(cache->get(*cq, &rawCachedSolution));
+
+        // Get planner params.
+        QueryPlannerParams plannerParams;
+        plannerParams.options = plannerOptions;
+        fillOutPlannerParams(&_txn, collection, cq.get(), &plannerParams);
+
+        // The queued data stage returns the document {_id: 8} during the trial period, and then
+        // takes a long time to make any further progress.
+        auto ws = stdx::make_unique<WorkingSet>();
+        auto mockChild = stdx::make_unique<QueuedDataStage>(&_txn, ws.get());
+        auto cursor = collection->getCursor(&_txn);
+        while (auto record = cursor->next()) {
+            BSONObj obj = record->data.releaseToBson().getOwned();
+            if (obj["_id"].numberInt() != 8) {
+                continue;
+            }
+            WorkingSetID id = ws->allocate();
+            WorkingSetMember* member = ws->get(id);
+            member->recordId = record->id;
+            member->obj = Snapshotted<BSONObj>(SnapshotId(), obj);
+            ws->transitionToRecordIdAndObj(id);
+            mockChild->pushBack(id);
+        }
+        cursor.reset();
+
+        const size_t decisionWorks = 10;
+        const size_t mockWorks =
+            1U + static_cast<size_t>(internalQueryCacheEvictionRatio * decisionWorks);
+        for (size_t i = 0; i < mockWorks; i++) {
+            mockChild->pushBack(PlanStage::NEED_TIME);
+        }
+
+        auto cachedPlanStage = stdx::make_unique<CachedPlanStage>(&_txn,
+                                                                  collection,
+                                                                  ws.get(),
+                                                                  cq.get(),
+                                                                  plannerParams,
+                                                                  decisionWorks,
+                                                                  mockChild.release());
+
+        // The trial period, run when the executor is made, succeeds without replanning.
+        auto statusWithExec = PlanExecutor::make(
+            &_txn, std::move(ws), std::move(cachedPlanStage), collection, yieldPolicy);
+        ASSERT_OK(statusWithExec.getStatus());
+        const std::unique_ptr<PlanExecutor> exec = std::move(statusWithExec.getValue());
+
+        // Make sure that we get each of the legit results back exactly once. Without a replan, the
+        // mock stage only produces one of them.
+        std::set<int> ids;
+        size_t numResults = 0;
+        BSONObj obj;
+        PlanExecutor::ExecState state;
+        while (PlanExecutor::ADVANCED == (state = exec->getNext(&obj, NULL))) {
+            ASSERT(cq->root()->matchesBSON(obj));
+            ids.insert(obj["_id"].numberInt());
+            numResults++;
+        }
+        ASSERT_EQ(PlanExecutor::IS_EOF, state);
+
+        const size_t expectedResults = expectReplan ? 2U : 1U;
+        ASSERT_EQ(numResults, expectedResults);
+        ASSERT_EQ(ids.size(), expectedResults);
+
+        const CachedPlanStats* stats =
+            static_cast<const CachedPlanStats*>(exec->getRootStage()->getSpecificStats());
+        ASSERT_EQ(stats->replannedMidQuery, expectReplan);
+
+        // Replanning mid-query writes a new plan cache entry.
+        if (expectReplan) {
+            ASSERT_OK(cache->get(*cq, &rawCachedSolution));
+            const std::unique_ptr<CachedSolution> cachedSolution(rawCachedSolution);
+        } else {
+            ASSERT_NOT_OK(cache->get(*cq, &rawCachedSolution));
+        }
+
+        internalQueryPlanEvaluationMaxResults.store(oldMaxResults);
+        internalQueryCacheEnableMidQueryReplanning.store(oldEnableMidQueryReplanning);
+    }
+};
+
+/**
+ * Test that a cached plan at the root of a find which stops producing results after its trial
+ * period is replanned mid-query, and that results returned before the switch are not returned
+ * again.
+ */
+class QueryStageCachedPlanMidQueryReplan : public QueryStageCachedPlanMidQueryReplanBase {
+public:
+    void run() {
+        const bool expectReplan = true;
+        runStalledCachedPlan(
+            QueryPlannerParams::PRIVATE_IS_FIND, PlanExecutor::YIELD_MANUAL, expectReplan);
+    }
+};
+
+/**
+ * Test that a write conflict hit by a candidate plan while replanning mid-query is retried by
+ * yielding under the executor's yield policy, rather than thrown out of the executor.
+ */
+class QueryStageCachedPlanMidQueryReplanWriteConflict
+    : public QueryStageCachedPlanMidQueryReplanBase {
+public:
+    void run() {
+        // The trial period of the cached plan does not use a MultiPlanStage, so the write
+        // conflict is hit during the mid-query replan.
+        FailPoint* failPoint =
+            getGlobalFailPointRegistry()->getFailPoint("multiPlanStageWriteConflict");
+        ASSERT(failPoint);
+        failPoint->setMode(FailPoint::nTimes, 1);
+        ON_BLOCK_EXIT([failPoint] { failPoint->setMode(FailPoint::off); });
+
+        const bool expectReplan = true;
+        runStalledCachedPlan(
+            QueryPlannerParams::PRIVATE_IS_FIND, PlanExecutor::YIELD_AUTO, expectReplan);
+    }
+};
+
+/**
+ * Test that a cached plan is not replanned mid-query unless it is the root of a find, since
+ * parent stages of other operations share its working set.
+ */
+class QueryStageCachedPlanNoMidQueryReplanOutsideFind
+    : public QueryStageCachedPlanMidQueryReplanBase {
+public:
+    void run() {
+        const bool expectReplan = false;
+        runStalledCachedPlan(QueryPlannerParams::DEFAULT, PlanExecutor::YIELD_MANUAL, expectReplan);
+    }
+};
+
 class All : public Suite {
 public:
     All() : Suite("query_stage_cached_plan") {}
@@ -242,6 +411,9 @@ public:
     void setupTests() {
         add<QueryStageCachedPlanFailure>();
         add<QueryStageCachedPlanHitMaxWorks>();
+        add<QueryStageCachedPlanMidQueryReplan>();
+        add<QueryStageCachedPlanMidQueryReplanWriteConflict>();
+        add<QueryStageCachedPlanNoMidQueryReplanOutsideFind>();
     }
 };
 
@@ -36,9 +36,14 @@
 #include "mongo/db/exec/count_scan.h"
 #include "mongo/db/exec/keep_mutations.h"
 #include "mongo/db/exec/working_set.h"
+#include "mongo/db/hasher.h"
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
 #include "mongo/db/operation_context_impl.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/get_executor.h"
+#include "mongo/db/range_arithmetic.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/fail_point_registry.h"
@@ -635,6 +640,193 @@ public:
     }
 };
 
+class OwnedRangesCountBase : public CountBase {
+protected:
+    /**
+     * Counts the documents matching 'query' whose shard key 'shardKey' falls into 'ownedRanges',
+     * using the plan built by getOwnedRangesCountScan(). Returns -1 if no such plan can be built.
+     * The number of count scans in the plan is returned through 'numScans'.
+     */
+    int countOwned(Collection* collection,
+                   const BSONObj& query,
+                   const BSONObj& shardKey,
+                   const RangeMap& ownedRanges,
+                   size_t* numScans = nullptr) {
+        auto statusWithCQ = CanonicalQuery::canonicalize(
+            NamespaceString(ns()), query, ExtensionsCallbackDisallowExtensions());
+        ASSERT_OK(statusWithCQ.getStatus());
+
+        WorkingSet ws;
+        std::unique_ptr<PlanStage> stage = getOwnedRangesCountScan(
+            &_txn, collection, &ws, *statusWithCQ.getValue(), shardKey, ownedRanges);
+        if (!stage) {
+            return -1;
+        }
+
+        if (numScans) {
+            *numScans = stage->getChildren().size();
+        }
+
+        int numCounted = 0;
+        WorkingSetID wsid;
+        PlanStage::StageState state;
+        while (PlanStage::IS_EOF != (state = stage->work(&wsid))) {
+            ASSERT_NE(PlanStage::FAILURE, state);
+            if (PlanStage::ADVANCED == state) {
+                numCounted++;
+            }
+        }
+        return numCounted;
+    }
+
+    /**
+     * Inserts {a: i, b: i % 2} for i in [0, 100) and indexes 'indexKey'.
+     */
+    void insertDocs(const BSONObj& indexKey) {
+        for (int i = 0; i < 100; i++) {
+            insert(BSON("a" << i << "b" << i % 2));
+        }
+        addIndex(indexKey);
+    }
+
+    /**
+     * The ranges [MinKey, 20) and [50, MaxKey) of the shard key {a: 1}. Documents with a in
+     * [20, 50) are orphans.
+     */
+    static RangeMap twoOwnedRanges() {
+        RangeMap ranges;
+        ranges.insert(std::make_pair(BSON("a" << MINKEY), BSON("a" << 20)));
+        ranges.insert(std::make_pair(BSON("a" << 50), BSON("a" << MAXKEY)));
+        return ranges;
+    }
+};
+
+//
+// Check that an empty predicate counts the keys of every owned range, one scan per range, and
+// leaves out the orphans in between
+//
+class QueryStageCountScanOwnedRangesEmptyPredicate : public OwnedRangesCountBase {
+public:
+    void run() {
+        OldClientWriteContext ctx(&_txn, ns());
+        insertDocs(BSON("a" << 1));
+        Collection* collection = ctx.getCollection();
+        const BSONObj shardKey = BSON("a" << 1);
+
+        size_t numScans = 0;
+        ASSERT_EQUALS(70, countOwned(collection, BSONObj(), shardKey, twoOwnedRanges(), &numScans));
+        ASSERT_EQUALS(2U, numScans);
+    }
+};
+
+//
+// Check that a predicate mapping to a single interval of the shard key index is clipped to each
+// owned range
+//
+class QueryStageCountScanOwnedRangesSingleInterval : public OwnedRangesCountBase {
+public:
+    void run() {
+        OldClientWriteContext ctx(&_txn, ns());
+        insertDocs(BSON("a" << 1));
+        Collection* collection = ctx.getCollection();
+        const BSONObj shardKey = BSON("a" << 1);
+
+        // [10, 20) and [50, 60) are owned, [20, 50) holds orphans.
+        ASSERT_EQUALS(20,
+                      countOwned(collection,
+                                 fromjson("{a: {$gte: 10, $lt: 60}}"),
+                                 shardKey,
+                                 twoOwnedRanges()));
+
+        // Entirely within the orphaned range.
+        ASSERT_EQUALS(0,
+                      countOwned(collection,
+                                 fromjson("{a: {$gte: 25, $lte: 45}}"),
+                                 shardKey,
+                                 twoOwnedRanges()));
+
+        // Point predicates, on either side of an owned range's exclusive upper bound.
+        ASSERT_EQUALS(1, countOwned(collection, fromjson("{a: 19}"), shardKey, twoOwnedRanges()));
+        ASSERT_EQUALS(0, countOwned(collection, fromjson("{a: 20}"), shardKey, twoOwnedRanges()));
+    }
+};
+
+//
+// Check that no plan is built for a predicate the shard key index cannot answer, so that the
+// caller falls back to filtering by shard ownership
+//
+class QueryStageCountScanOwnedRangesNotCovered : public OwnedRangesCountBase {
+public:
+    void run() {
+        OldClientWriteContext ctx(&_txn, ns());
+        insertDocs(BSON("a" << 1));
+        Collection* collection = ctx.getCollection();
+        const BSONObj shardKey = BSON("a" << 1);
+
+        ASSERT_EQUALS(-1, countOwned(collection, fromjson("{b: 1}"), shardKey, twoOwnedRanges()));
+        ASSERT_EQUALS(-1,
+                      countOwned(collection,
+                                 fromjson("{a: {$gte: 10}, b: 1}"),
+                                 shardKey,
+                                 twoOwnedRanges()));
+
+        // No plan either without an index on the shard key.
+        ASSERT_EQUALS(-1, countOwned(collection, BSONObj(), BSON("b" << 1), twoOwnedRanges()));
+    }
+};
+
+//
+// Check that a shard which owns no chunks counts nothing, without scanning the index
+//
+class QueryStageCountScanOwnedRangesNoChunks : public OwnedRangesCountBase {
+public:
+    void run() {
+        OldClientWriteContext ctx(&_txn, ns());
+        insertDocs(BSON("a" << 1));
+        Collection* collection = ctx.getCollection();
+        const BSONObj shardKey = BSON("a" << 1);
+
+        size_t numScans = 1;
+        ASSERT_EQUALS(0, countOwned(collection, BSONObj(), shardKey, RangeMap(), &numScans));
+        ASSERT_EQUALS(0U, numScans);
+    }
+};
+
+//
+// Check that the owned ranges of a hashed shard key are applied to the hashed index keys
+//
+class QueryStageCountScanOwnedRangesHashedShardKey : public OwnedRangesCountBase {
+public:
+    void run() {
+        OldClientWriteContext ctx(&_txn, ns());
+        insertDocs(BSON("a"
+                        << "hashed"));
+        Collection* collection = ctx.getCollection();
+
+        // Own only the negative half of the hash space.
+        RangeMap ranges;
+        ranges.insert(std::make_pair(BSON("a" << MINKEY), BSON("a" << 0LL)));
+
+        int expected = 0;
+        for (int i = 0; i < 100; i++) {
+            const BSONObj key = BSON("a" << i);
+            if (BSONElementHasher::hash64(key.firstElement(),
+                                          BSONElementHasher::DEFAULT_HASH_SEED) < 0) {
+                expected++;
+            }
+        }
+        ASSERT_GREATER_THAN(expected, 0);
+        ASSERT_LESS_THAN(expected, 100);
+
+        ASSERT_EQUALS(expected,
+                      countOwned(collection,
+                                 BSONObj(),
+                                 BSON("a"
+                                      << "hashed"),
+                                 ranges));
+    }
+};
+
 class All : public Suite {
 public:
     All() : Suite("query_stage_count_scan") {}
@@ -651,6 +843,11 @@ public:
         add<QueryStageCountScanInsertNewDocsDuringYield>();
         add<QueryStageCountScanBecomesMultiKeyDuringYield>();
         add<QueryStageCountScanUnusedKeys>();
+        add<QueryStageCountScanOwnedRangesEmptyPredicate>();
+        add<QueryStageCountScanOwnedRangesSingleInterval>();
+        add<QueryStageCountScanOwnedRangesNotCovered>();
+        add<QueryStageCountScanOwnedRangesNoChunks>();
+        add<QueryStageCountScanOwnedRangesHashedShardKey>();
     }
 };
 
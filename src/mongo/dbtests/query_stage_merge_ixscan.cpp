@@ -0,0 +1,277 @@
+/**
+ * Copyright (C) 2016 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/client/dbclientcursor.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/database.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/exec/merge_index_scan.h"
+#include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/working_set.h"
+#include "mongo/db/json.h"
+#include "mongo/db/operation_context_impl.h"
+#include "mongo/db/query/index_bounds_builder.h"
+#include "mongo/dbtests/dbtests.h"
+
+/**
+ * This file tests db/exec/merge_index_scan.cpp
+ */
+
+namespace QueryStageMergeIndexScan {
+
+using std::set;
+using std::vector;
+
+class QueryStageMergeIndexScanBase {
+public:
+    QueryStageMergeIndexScanBase() : _client(&_txn), _ctx(&_txn, ns()) {
+        _client.dropCollection(ns());
+        addIndex(keyPattern());
+    }
+
+    virtual ~QueryStageMergeIndexScanBase() {
+        _client.dropCollection(ns());
+    }
+
+    void addIndex(const BSONObj& obj) {
+        ASSERT_OK(dbtests::createIndex(&_txn, ns(), obj));
+    }
+
+    void insert(const BSONObj& obj) {
+        _client.insert(ns(), obj);
+    }
+
+    void remove(const BSONObj& obj) {
+        _client.remove(ns(), obj);
+    }
+
+    Collection* getCollection() {
+        return _ctx.db()->getCollection(ns());
+    }
+
+    RecordId getRecordIdFor(const BSONObj& query) {
+        BSONObj doc = _client.findOne(ns(), query);
+        auto cursor = getCollection()->getCursor(&_txn);
+        while (auto record = cursor->next()) {
+            if (record->data.toBson() == doc) {
+                return record->id;
+            }
+        }
+        FAIL("Expected to find a document");
+        return RecordId();
+    }
+
+    /**
+     * Returns a MERGE_IXSCAN over the index {a: 1, b: 1} for the point intervals 'points' on 'a'
+     * and all values of 'b'.
+     */
+    MergeIndexScan* createMergeIndexScan(const vector<int>& points, int direction) {
+        IndexScanParams params;
+        params.descriptor =
+            getCollection()->getIndexCatalog()->findIndexByKeyPattern(&_txn, keyPattern());
+        invariant(params.descriptor);
+        params.direction = direction;
+        params.bounds.isSimpleRange = false;
+
+        OrderedIntervalList aOil("a");
+        for (int point : points) {
+            aOil.intervals.push_back(IndexBoundsBuilder::makePointInterval(point));
+        }
+        params.bounds.fields.push_back(aOil);
+
+        OrderedIntervalList bOil("b");
+        bOil.intervals.push_back(IndexBoundsBuilder::allValues());
+        params.bounds.fields.push_back(bOil);
+
+        IndexBoundsBuilder::alignBounds(&params.bounds, keyPattern(), direction);
+
+        return new MergeIndexScan(&_txn, params, 1, &_ws, NULL);
+    }
+
+    /**
+     * Works 'stage' until it produces a result, and returns the result's value for 'b'. Returns
+     * -1 if the stage hits EOF instead.
+     */
+    int getNextB(PlanStage* stage, RecordId* recordIdOut = NULL) {
+        while (!stage->isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            PlanStage::StageState state = stage->work(&id);
+            if (PlanStage::ADVANCED != state) {
+                continue;
+            }
+
+            WorkingSetMember* member = _ws.get(id);
+            ASSERT_EQUALS(1U, member->keyData.size());
+            BSONObjIterator keyIt(member->keyData[0].keyData);
+            keyIt.next();
+            int b = keyIt.next().numberInt();
+            if (recordIdOut) {
+                *recordIdOut = member->recordId;
+            }
+            _ws.free(id);
+            return b;
+        }
+        return -1;
+    }
+
+    static BSONObj keyPattern() {
+        return BSON("a" << 1 << "b" << 1);
+    }
+
+    static const char* ns() {
+        return "unittests.QueryStageMergeIndexScan";
+    }
+
+protected:
+    OperationContextImpl _txn;
+    DBDirectClient _client;
+    OldClientWriteContext _ctx;
+    WorkingSet _ws;
+};
+
+// find({a: {$in: [0, ..., 9]}}).sort({b: 1}) with index {a: 1, b: 1}.
+class QueryStageMergeIndexScanForward : public QueryStageMergeIndexScanBase {
+public:
+    void run() {
+        const int N = 100;
+        for (int i = 0; i < N; ++i) {
+            insert(BSON("a" << i % 10 << "b" << i));
+        }
+
+        vector<int> points;
+        for (int i = 0; i < 10; ++i) {
+            points.push_back(i);
+        }
+
+        std::unique_ptr<MergeIndexScan> scan(createMergeIndexScan(points, 1));
+        for (int i = 0; i < N; ++i) {
+            ASSERT_EQUALS(i, getNextB(scan.get()));
+        }
+        ASSERT_EQUALS(-1, getNextB(scan.get()));
+
+        // Each of the point intervals needs at least one seek to get started.
+        const IndexScanStats* stats =
+            static_cast<const IndexScanStats*>(scan->getSpecificStats());
+        ASSERT_GTE(stats->seeks, 10U);
+    }
+};
+
+// find({a: {$in: [0, ..., 9]}}).sort({b: -1}) with index {a: 1, b: 1}.
+class QueryStageMergeIndexScanReverse : public QueryStageMergeIndexScanBase {
+public:
+    void run() {
+        const int N = 100;
+        for (int i = 0; i < N; ++i) {
+            insert(BSON("a" << i % 10 << "b" << i));
+        }
+
+        vector<int> points;
+        for (int i = 0; i < 10; ++i) {
+            points.push_back(i);
+        }
+
+        std::unique_ptr<MergeIndexScan> scan(createMergeIndexScan(points, -1));
+        for (int i = N - 1; i >= 0; --i) {
+            ASSERT_EQUALS(i, getNextB(scan.get()));
+        }
+        ASSERT_EQUALS(-1, getNextB(scan.get()));
+    }
+};
+
+// Documents with equal keys, and documents matching several point intervals of a multikey
+// index, are each returned exactly once.
+class QueryStageMergeIndexScanDups : public QueryStageMergeIndexScanBase {
+public:
+    void run() {
+        const int N = 20;
+        for (int i = 0; i < N; ++i) {
+            insert(BSON("a" << BSON_ARRAY(1 << 2) << "b" << i / 4));
+        }
+
+        std::unique_ptr<MergeIndexScan> scan(createMergeIndexScan({1, 2, 3}, 1));
+        set<RecordId> seen;
+        int lastB = 0;
+        for (int i = 0; i < N; ++i) {
+            RecordId recordId;
+            int b = getNextB(scan.get(), &recordId);
+            ASSERT_GTE(b, lastB);
+            ASSERT(seen.insert(recordId).second);
+            lastB = b;
+        }
+        ASSERT_EQUALS(-1, getNextB(scan.get()));
+
+        const IndexScanStats* stats =
+            static_cast<const IndexScanStats*>(scan->getSpecificStats());
+        ASSERT_EQUALS(static_cast<size_t>(N), stats->dupsDropped);
+    }
+};
+
+// A buffered entry whose document is deleted during a yield is not returned.
+class QueryStageMergeIndexScanInvalidation : public QueryStageMergeIndexScanBase {
+public:
+    void run() {
+        const int N = 10;
+        for (int i = 0; i < N; ++i) {
+            insert(BSON("a" << i % 2 << "b" << i));
+        }
+
+        std::unique_ptr<MergeIndexScan> scan(createMergeIndexScan({0, 1}, 1));
+        ASSERT_EQUALS(0, getNextB(scan.get()));
+
+        // {a: 1, b: 1} is buffered as the next entry of the scan over a == 1.
+        RecordId toDelete = getRecordIdFor(BSON("b" << 1));
+        scan->saveState();
+        scan->invalidate(&_txn, toDelete, INVALIDATION_DELETION);
+        remove(BSON("b" << 1));
+        scan->restoreState();
+
+        for (int i = 2; i < N; ++i) {
+            ASSERT_EQUALS(i, getNextB(scan.get()));
+        }
+        ASSERT_EQUALS(-1, getNextB(scan.get()));
+    }
+};
+
+class All : public Suite {
+public:
+    All() : Suite("query_stage_merge_ixscan") {}
+
+    void setupTests() {
+        add<QueryStageMergeIndexScanForward>();
+        add<QueryStageMergeIndexScanReverse>();
+        add<QueryStageMergeIndexScanDups>();
+        add<QueryStageMergeIndexScanInvalidation>();
+    }
+};
+
+SuiteInstance<All> queryStageMergeIndexScanAll;
+
+}  // namespace QueryStageMergeIndexScan
@@ -40,6 +40,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/db/write_concern_options.h"
 #include "mongo/s/balancer_policy.h"
@@ -56,6 +57,7 @@
 #include "mongo/s/client/shard.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/migration_secondary_throttle_options.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
@@ -80,10 +82,11 @@ class BalanceRoundDetails {
 public:
     BalanceRoundDetails() : _executionTimer() {}
 
-    void setSucceeded(int candidateChunks, int chunksMoved) {
+    void setSucceeded(int candidateChunks, int chunksMoved, const BSONObj& migrationStats) {
         invariant(!_errMsg);
         _candidateChunks = candidateChunks;
         _chunksMoved = chunksMoved;
+        _migrationStats = migrationStats;
     }
 
     void setFailed(const string& errMsg) {
@@ -100,6 +103,7 @@ public:
         } else {
             builder.append("candidateChunks", _candidateChunks);
             builder.append("chunksMoved", _chunksMoved);
+            builder.appendElements(_migrationStats);
         }
 
         return builder.obj();
@@ -111,6 +115,7 @@ private:
     // Set only on success
     int _candidateChunks{0};
     int _chunksMoved{0};
+    BSONObj _migrationStats;
 
     // Set only on failure
     boost::optional<std::string> _errMsg;
@@ -124,6 +129,16 @@ MONGO_FP_DECLARE(balancerRoundIntervalSetting);
 namespace {
 const Seconds kBalanceRoundDefaultInterval(10);
 const Seconds kShortBalanceRoundInterval(1);
+
+// Maximum number of chunk migrations the balancer issues at the same time. Migrations run in
+// parallel only between disjoint pairs of shards. Configurable with server parameter
+// "balancerMaxParallelMigrations".
+std::atomic<int> balancerMaxParallelMigrations(1);  // NOLINT
+
+ExportedServerParameter<int, ServerParameterType::kStartupAndRuntime>
+    balancerMaxParallelMigrationsConfig(ServerParameterSet::getGlobal(),
+                                        "balancerMaxParallelMigrations",
+                                        &balancerMaxParallelMigrations);
 }
 
 Balancer balancer;
@@ -135,10 +150,20 @@ Balancer::~Balancer() = default;
 int Balancer::_moveChunks(OperationContext* txn,
                           const vector<shared_ptr<MigrateInfo>>& candidateChunks,
                           const MigrationSecondaryThrottleOptions& secondaryThrottle,
-                          bool waitForDelete) {
+                          bool waitForDelete,
+                          BSONObjBuilder* statsBuilder) {
     int movedCount = 0;
+    int numBatches = 0;
+
+    const int maxParallel = std::max(1, balancerMaxParallelMigrations.load());
+
+    BSONArrayBuilder migrationsBuilder(statsBuilder->subarrayStart("migrations"));
+
+    // Migrations which could not be scheduled in the current batch, because one of their shards
+    // is already busy, are deferred to a later one.
+    vector<shared_ptr<MigrateInfo>> pending(candidateChunks);
 
-    for (const auto& migrateInfo : candidateChunks) {
+    while (!pending.empty()) {
         // If the balancer was disabled since we started this round, don't start new chunks
         // moves.
         const auto balSettingsResult =
@@ -149,7 +174,7 @@ int Balancer::_moveChunks(OperationContext* txn,
 
         if (!balSettingsResult.isOK() && !isBalSettingsAbsent) {
             warning() << balSettingsResult.getStatus();
-            return movedCount;
+            break;
         }
 
         const SettingsType& balancerConfig =
@@ -158,97 +183,168 @@ int Balancer::_moveChunks(OperationContext* txn,
         if ((!isBalSettingsAbsent && !grid.shouldBalance(balancerConfig)) ||
             MONGO_FAIL_POINT(skipBalanceRound)) {
             LOG(1) << "Stopping balancing round early as balancing was disabled";
-            return movedCount;
+            break;
         }
 
-        // Changes to metadata, borked metadata, and connectivity problems between shards
-        // should cause us to abort this chunk move, but shouldn't cause us to abort the entire
-        // round of chunks.
-        //
-        // TODO(spencer): We probably *should* abort the whole round on issues communicating
-        // with the config servers, but its impossible to distinguish those types of failures
-        // at the moment.
-        //
-        // TODO: Handle all these things more cleanly, since they're expected problems
+        MigrationBatch migrationBatch = BalancerPolicy::selectMigrationBatch(pending, maxParallel);
+        const vector<shared_ptr<MigrateInfo>>& batch = migrationBatch.migrations;
 
-        const NamespaceString nss(migrateInfo->ns);
+        const int queueDepth = static_cast<int>(migrationBatch.deferred.size());
+        pending.swap(migrationBatch.deferred);
+        numBatches++;
 
-        try {
-            shared_ptr<DBConfig> cfg =
-                uassertStatusOK(grid.catalogCache()->getDatabase(txn, nss.db().toString()));
+        vector<MigrationResult> results(batch.size());
 
-            // NOTE: We purposely do not reload metadata here, since _doBalanceRound already
-            // tried to do so once.
-            shared_ptr<ChunkManager> cm = cfg->getChunkManager(txn, migrateInfo->ns);
-            uassert(28628,
-                    str::stream()
-                        << "Collection " << migrateInfo->ns
-                        << " was deleted while balancing was active. Aborting balancing round.",
-                    cm);
+        if (batch.size() == 1) {
+            results[0] = _moveChunk(txn, *batch[0], secondaryThrottle, waitForDelete);
+        } else {
+            // Each migration blocks on its donor shard until the move is committed, so issue them
+            // from separate threads, each with its own client and operation context.
+            vector<stdx::thread> threads;
+            for (size_t i = 0; i < batch.size(); i++) {
+                threads.emplace_back(
+                    [this, &batch, &results, &secondaryThrottle, waitForDelete, i] {
+                        Client::initThread("BalancerMigration");
+                        auto migrationTxn = cc().makeOperationContext();
+
+                        try {
+                            results[i] = _moveChunk(
+                                migrationTxn.get(), *batch[i], secondaryThrottle, waitForDelete);
+                        } catch (const std::exception& ex) {
+                            warning() << "could not move chunk " << batch[i]->chunk.toString()
+                                      << causedBy(ex.what());
+                        }
+                    });
+            }
 
-            ChunkPtr c = cm->findIntersectingChunk(txn, migrateInfo->chunk.min);
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
 
-            if (c->getMin().woCompare(migrateInfo->chunk.min) ||
-                c->getMax().woCompare(migrateInfo->chunk.max)) {
-                // Likely a split happened somewhere, so force reload the chunk manager
-                cm = cfg->getChunkManager(txn, migrateInfo->ns, true);
-                invariant(cm);
+        for (size_t i = 0; i < batch.size(); i++) {
+            if (results[i].moved) {
+                movedCount++;
+            }
 
-                c = cm->findIntersectingChunk(txn, migrateInfo->chunk.min);
+            BSONObjBuilder migrationBuilder(migrationsBuilder.subobjStart());
+            migrationBuilder.append("ns", batch[i]->ns);
+            migrationBuilder.append("from", batch[i]->from);
+            migrationBuilder.append("to", batch[i]->to);
+            migrationBuilder.append("batch", numBatches);
+            migrationBuilder.append("queueDepth", queueDepth);
+            migrationBuilder.append("durationMillis", results[i].durationMillis);
+            migrationBuilder.append("moved", results[i].moved);
+            migrationBuilder.doneFast();
+        }
+    }
 
-                if (c->getMin().woCompare(migrateInfo->chunk.min) ||
-                    c->getMax().woCompare(migrateInfo->chunk.max)) {
-                    log() << "chunk mismatch after reload, ignoring will retry issue "
-                          << migrateInfo->chunk.toString();
+    migrationsBuilder.doneFast();
 
-                    continue;
-                }
-            }
+    statsBuilder->append("maxParallelMigrations", maxParallel);
+    statsBuilder->append("migrationBatches", numBatches);
 
-            BSONObj res;
-            if (c->moveAndCommit(txn,
-                                 migrateInfo->to,
-                                 Chunk::MaxChunkSize,
-                                 secondaryThrottle,
-                                 waitForDelete,
-                                 0, /* maxTimeMS */
-                                 res)) {
-                movedCount++;
-                continue;
+    return movedCount;
+}
+
+Balancer::MigrationResult Balancer::_moveChunk(
+    OperationContext* txn,
+    const MigrateInfo& migrateInfo,
+    const MigrationSecondaryThrottleOptions& secondaryThrottle,
+    bool waitForDelete) {
+    const Timer migrationTimer;
+    MigrationResult result;
+
+    // Changes to metadata, borked metadata, and connectivity problems between shards
+    // should cause us to abort this chunk move, but shouldn't cause us to abort the entire
+    // round of chunks.
+    //
+    // TODO(spencer): We probably *should* abort the whole round on issues communicating
+    // with the config servers, but its impossible to distinguish those types of failures
+    // at the moment.
+    //
+    // TODO: Handle all these things more cleanly, since they're expected problems
+
+    const NamespaceString nss(migrateInfo.ns);
+
+    try {
+        shared_ptr<DBConfig> cfg =
+            uassertStatusOK(grid.catalogCache()->getDatabase(txn, nss.db().toString()));
+
+        // NOTE: We purposely do not reload metadata here, since _doBalanceRound already
+        // tried to do so once.
+        shared_ptr<ChunkManager> cm = cfg->getChunkManager(txn, migrateInfo.ns);
+        uassert(28628,
+                str::stream()
+                    << "Collection " << migrateInfo.ns
+                    << " was deleted while balancing was active. Aborting balancing round.",
+                cm);
+
+        ChunkPtr c = cm->findIntersectingChunk(txn, migrateInfo.chunk.min);
+
+        if (c->getMin().woCompare(migrateInfo.chunk.min) ||
+            c->getMax().woCompare(migrateInfo.chunk.max)) {
+            // Likely a split happened somewhere, so force reload the chunk manager
+            cm = cfg->getChunkManager(txn, migrateInfo.ns, true);
+            invariant(cm);
+
+            c = cm->findIntersectingChunk(txn, migrateInfo.chunk.min);
+
+            if (c->getMin().woCompare(migrateInfo.chunk.min) ||
+                c->getMax().woCompare(migrateInfo.chunk.max)) {
+                log() << "chunk mismatch after reload, ignoring will retry issue "
+                      << migrateInfo.chunk.toString();
+
+                result.durationMillis = migrationTimer.millis();
+                return result;
             }
+        }
+
+        BSONObj res;
+        if (c->moveAndCommit(txn,
+                             migrateInfo.to,
+                             Chunk::MaxChunkSize,
+                             secondaryThrottle,
+                             waitForDelete,
+                             0, /* maxTimeMS */
+                             res)) {
+            result.moved = true;
+            result.durationMillis = migrationTimer.millis();
+            return result;
+        }
 
-            // The move requires acquiring the collection metadata's lock, which can fail.
-            log() << "balancer move failed: " << res << " from: " << migrateInfo->from
-                  << " to: " << migrateInfo->to << " chunk: " << migrateInfo->chunk;
+        // The move requires acquiring the collection metadata's lock, which can fail.
+        log() << "balancer move failed: " << res << " from: " << migrateInfo.from
+              << " to: " << migrateInfo.to << " chunk: " << migrateInfo.chunk;
 
-            if (res["chunkTooBig"].trueValue()) {
-                // Reload just to be safe
-                cm = cfg->getChunkManager(txn, migrateInfo->ns);
-                invariant(cm);
+        if (res["chunkTooBig"].trueValue()) {
+            // Reload just to be safe
+            cm = cfg->getChunkManager(txn, migrateInfo.ns);
+            invariant(cm);
 
-                c = cm->findIntersectingChunk(txn, migrateInfo->chunk.min);
+            c = cm->findIntersectingChunk(txn, migrateInfo.chunk.min);
 
-                log() << "performing a split because migrate failed for size reasons";
+            log() << "performing a split because migrate failed for size reasons";
 
-                Status status = c->split(txn, Chunk::normal, NULL, NULL);
-                log() << "split results: " << status;
+            Status status = c->split(txn, Chunk::normal, NULL, NULL);
+            log() << "split results: " << status;
 
-                if (!status.isOK()) {
-                    log() << "marking chunk as jumbo: " << c->toString();
+            if (!status.isOK()) {
+                log() << "marking chunk as jumbo: " << c->toString();
 
-                    c->markAsJumbo(txn);
+                c->markAsJumbo(txn);
 
-                    // We increment moveCount so we do another round right away
-                    movedCount++;
-                }
+                // We count this as a move so we do another round right away
+                result.moved = true;
             }
-        } catch (const DBException& ex) {
-            warning() << "could not move chunk " << migrateInfo->chunk.toString()
-                      << ", continuing balancing round" << causedBy(ex);
         }
+    } catch (const DBException& ex) {
+        warning() << "could not move chunk " << migrateInfo.chunk.toString()
+                  << ", continuing balancing round" << causedBy(ex);
     }
 
-    return movedCount;
+    result.durationMillis = migrationTimer.millis();
+    return result;
 }
 
 void Balancer::_ping(OperationContext* txn, bool waiting) {
@@ -636,16 +732,21 @@ void Balancer::run() {
                 vector<shared_ptr<MigrateInfo>> candidateChunks;
                 _doBalanceRound(txn.get(), &scopedDistLock.getValue(), &candidateChunks);
 
+                BSONObjBuilder migrationStats;
                 if (candidateChunks.size() == 0) {
                     LOG(1) << "no need to move any chunk";
                     _balancedLastTime = 0;
                 } else {
-                    _balancedLastTime =
-                        _moveChunks(txn.get(), candidateChunks, secondaryThrottle, waitForDelete);
+                    _balancedLastTime = _moveChunks(txn.get(),
+                                                    candidateChunks,
+                                                    secondaryThrottle,
+                                                    waitForDelete,
+                                                    &migrationStats);
                 }
 
                 roundDetails.setSucceeded(static_cast<int>(candidateChunks.size()),
-                                          _balancedLastTime);
+                                          _balancedLastTime,
+                                          migrationStats.obj());
 
                 grid.catalogManager(txn.get())
                     ->logAction(txn.get(), "balancer.round", "", roundDetails.toBSON());
@@ -36,6 +36,7 @@
 namespace mongo {
 
 class BalancerPolicy;
+class BSONObjBuilder;
 struct MigrateInfo;
 class MigrationSecondaryThrottleOptions;
 class OperationContext;
@@ -98,17 +99,42 @@ private:
                          std::vector<std::shared_ptr<MigrateInfo>>* candidateChunks);
 
     /**
-     * Issues chunk migration request, one at a time.
+     * Outcome of a single chunk migration issued by the balancer.
+     */
+    struct MigrationResult {
+        // Whether the chunk was moved (or marked as jumbo, which also warrants a quick new round)
+        bool moved{false};
+
+        // Time spent on the migration, including any split attempted after it failed
+        long long durationMillis{0};
+    };
+
+    /**
+     * Issues chunk migration requests in batches. Migrations within a batch involve disjoint pairs
+     * of shards and run concurrently, up to the "balancerMaxParallelMigrations" server parameter.
+     * Since _doBalanceRound() proposes at most one migration per collection, only migrations of
+     * different collections can run concurrently.
      *
      * @param candidateChunks possible chunks to move
      * @param writeConcern detailed write concern. NULL means the default write concern.
      * @param waitForDelete wait for deletes to complete after each chunk move
+     * @param statsBuilder receives per-migration timings and the queue depth of each batch
      * @return number of chunks effectively moved
      */
     int _moveChunks(OperationContext* txn,
                     const std::vector<std::shared_ptr<MigrateInfo>>& candidateChunks,
                     const MigrationSecondaryThrottleOptions& secondaryThrottle,
-                    bool waitForDelete);
+                    bool waitForDelete,
+                    BSONObjBuilder* statsBuilder);
+
+    /**
+     * Issues a single chunk migration request and waits for it to complete. If the chunk is too
+     * big to be moved, tries to split it or marks it as jumbo.
+     */
+    MigrationResult _moveChunk(OperationContext* txn,
+                               const MigrateInfo& migrateInfo,
+                               const MigrationSecondaryThrottleOptions& secondaryThrottle,
+                               bool waitForDelete);
 
     /**
      * Marks this balancer as being live on the config server(s).
@@ -499,6 +499,25 @@ MigrateInfo* BalancerPolicy::balance(const string& ns,
     return NULL;
 }
 
+MigrationBatch BalancerPolicy::selectMigrationBatch(
+    const vector<std::shared_ptr<MigrateInfo>>& candidates, int maxParallel) {
+    MigrationBatch batch;
+    set<ShardId> busyShards;
+
+    for (const auto& migrateInfo : candidates) {
+        if (static_cast<int>(batch.migrations.size()) < maxParallel &&
+            !busyShards.count(migrateInfo->from) && !busyShards.count(migrateInfo->to)) {
+            busyShards.insert(migrateInfo->from);
+            busyShards.insert(migrateInfo->to);
+            batch.migrations.push_back(migrateInfo);
+        } else {
+            batch.deferred.push_back(migrateInfo);
+        }
+    }
+
+    return batch;
+}
+
 
 ShardInfo::ShardInfo(long long maxSizeMB,
                      long long currSizeMB,
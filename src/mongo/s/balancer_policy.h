@@ -131,6 +131,15 @@ struct MigrateInfo {
     const ChunkInfo chunk;
 };
 
+/**
+ * A group of migrations which the balancer can issue concurrently, and the candidate migrations
+ * which have to wait for a later batch.
+ */
+struct MigrationBatch {
+    std::vector<std::shared_ptr<MigrateInfo>> migrations;
+    std::vector<std::shared_ptr<MigrateInfo>> deferred;
+};
+
 typedef std::map<ShardId, ShardInfo> ShardInfoMap;
 typedef std::map<ShardId, std::vector<ChunkType>> ShardToChunksMap;
 
@@ -234,6 +243,15 @@ public:
     static MigrateInfo* balance(const std::string& ns,
                                 const DistributionStatus& distribution,
                                 int balancedLastTime);
+
+    /**
+     * Picks, in order, the migrations from 'candidates' which can run at the same time. A shard
+     * can only donate or receive one chunk at a time, so no shard appears twice in the batch, and
+     * at most 'maxParallel' migrations are picked. The other candidates are returned as deferred,
+     * in their original order.
+     */
+    static MigrationBatch selectMigrationBatch(
+        const std::vector<std::shared_ptr<MigrateInfo>>& candidates, int maxParallel);
 };
 
 }  // namespace mongo
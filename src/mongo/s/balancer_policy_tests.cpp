@@ -620,4 +620,105 @@ TEST(BalancerPolicyTests, Simulation) {
     }
 }
 
+std::shared_ptr<MigrateInfo> makeMigration(const string& from,
+                                           const string& to,
+                                           int chunkMin,
+                                           const string& ns = "test.foo") {
+    return std::make_shared<MigrateInfo>(ns,
+                                         to,
+                                         from,
+                                         BSON(ChunkType::min(BSON("x" << chunkMin))
+                                              << ChunkType::max(BSON("x" << chunkMin + 1))));
+}
+
+TEST(BalancerPolicyTests, MigrationBatchDefersOverlappingShards) {
+    vector<std::shared_ptr<MigrateInfo>> candidates{makeMigration("shard0", "shard1", 0),
+                                                    makeMigration("shard1", "shard2", 1),
+                                                    makeMigration("shard3", "shard0", 2),
+                                                    makeMigration("shard2", "shard3", 3)};
+
+    MigrationBatch batch = BalancerPolicy::selectMigrationBatch(candidates, 10);
+
+    // The second and third migrations share a shard with the first one.
+    ASSERT_EQUALS(2U, batch.migrations.size());
+    ASSERT_EQUALS(candidates[0], batch.migrations[0]);
+    ASSERT_EQUALS(candidates[3], batch.migrations[1]);
+
+    ASSERT_EQUALS(2U, batch.deferred.size());
+    ASSERT_EQUALS(candidates[1], batch.deferred[0]);
+    ASSERT_EQUALS(candidates[2], batch.deferred[1]);
+
+    // The deferred migrations are disjoint, so they all go in the next batch.
+    MigrationBatch nextBatch = BalancerPolicy::selectMigrationBatch(batch.deferred, 10);
+    ASSERT_EQUALS(2U, nextBatch.migrations.size());
+    ASSERT_EQUALS(0U, nextBatch.deferred.size());
+}
+
+TEST(BalancerPolicyTests, MigrationBatchRespectsMaxParallel) {
+    vector<std::shared_ptr<MigrateInfo>> candidates{makeMigration("shard0", "shard1", 0),
+                                                    makeMigration("shard2", "shard3", 1),
+                                                    makeMigration("shard4", "shard5", 2),
+                                                    makeMigration("shard6", "shard7", 3)};
+
+    MigrationBatch batch = BalancerPolicy::selectMigrationBatch(candidates, 3);
+    ASSERT_EQUALS(3U, batch.migrations.size());
+    ASSERT_EQUALS(1U, batch.deferred.size());
+    ASSERT_EQUALS(candidates[3], batch.deferred[0]);
+
+    // A cap of one keeps the migrations serial.
+    MigrationBatch serialBatch = BalancerPolicy::selectMigrationBatch(candidates, 1);
+    ASSERT_EQUALS(1U, serialBatch.migrations.size());
+    ASSERT_EQUALS(candidates[0], serialBatch.migrations[0]);
+    ASSERT_EQUALS(3U, serialBatch.deferred.size());
+}
+
+TEST(BalancerPolicyTests, MigrationBatchQueueDepth) {
+    // Every migration involves shard0, so only one can run in each batch and the queue drains by
+    // one per batch.
+    vector<std::shared_ptr<MigrateInfo>> pending{makeMigration("shard0", "shard1", 0),
+                                                 makeMigration("shard0", "shard2", 1),
+                                                 makeMigration("shard3", "shard0", 2)};
+
+    vector<size_t> queueDepths;
+    while (!pending.empty()) {
+        MigrationBatch batch = BalancerPolicy::selectMigrationBatch(pending, 2);
+        ASSERT_EQUALS(1U, batch.migrations.size());
+        queueDepths.push_back(batch.deferred.size());
+        pending.swap(batch.deferred);
+    }
+
+    ASSERT_EQUALS(3U, queueDepths.size());
+    ASSERT_EQUALS(2U, queueDepths[0]);
+    ASSERT_EQUALS(1U, queueDepths[1]);
+    ASSERT_EQUALS(0U, queueDepths[2]);
+}
+
+TEST(BalancerPolicyTests, MigrationBatchAcrossCollections) {
+    // A balancer round proposes at most one migration per collection, so the migrations of a
+    // batch come from different collections.
+    vector<std::shared_ptr<MigrateInfo>> candidates{
+        makeMigration("shard0", "shard1", 0, "test.foo"),
+        makeMigration("shard0", "shard2", 0, "test.bar"),
+        makeMigration("shard3", "shard4", 0, "test.baz"),
+        makeMigration("shard2", "shard5", 0, "other.foo")};
+
+    MigrationBatch batch = BalancerPolicy::selectMigrationBatch(candidates, 4);
+
+    // The migration of test.bar shares its donor with the migration of test.foo.
+    ASSERT_EQUALS(3U, batch.migrations.size());
+    ASSERT_EQUALS("test.foo", batch.migrations[0]->ns);
+    ASSERT_EQUALS("test.baz", batch.migrations[1]->ns);
+    ASSERT_EQUALS("other.foo", batch.migrations[2]->ns);
+
+    ASSERT_EQUALS(1U, batch.deferred.size());
+    ASSERT_EQUALS("test.bar", batch.deferred[0]->ns);
+}
+
+TEST(BalancerPolicyTests, MigrationBatchEmpty) {
+    MigrationBatch batch =
+        BalancerPolicy::selectMigrationBatch(vector<std::shared_ptr<MigrateInfo>>(), 4);
+    ASSERT(batch.migrations.empty());
+    ASSERT(batch.deferred.empty());
+}
+
 }  // namespace
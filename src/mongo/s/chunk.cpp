@@ -53,6 +53,7 @@
 #include "mongo/s/migration_secondary_throttle_options.h"
 #include "mongo/s/move_chunk_request.h"
 #include "mongo/s/shard_key_pattern.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
@@ -197,7 +198,13 @@ Chunk::Chunk(const ChunkManager* info,
       _dataWritten(mkDataWritten()) {}
 
 int Chunk::mkDataWritten() {
-    PseudoRandom r(static_cast<int64_t>(time(0)));
+    // Seeded once per process from a secure source. Seeding from the current time made all the
+    // chunks loaded within the same second, on every mongos, reach the split test together and
+    // send redundant splitVector requests to the shard.
+    static stdx::mutex randomMutex;
+    static PseudoRandom r(std::unique_ptr<SecureRandom>(SecureRandom::create())->nextInt64());
+
+    stdx::lock_guard<stdx::mutex> lk(randomMutex);
     return r.nextInt32(MaxChunkSize / ChunkManager::SplitHeuristics::splitTestFactor);
 }
 
@@ -198,6 +198,7 @@ void ChunkManager::loadExistingRanges(OperationContext* txn, const ChunkManager*
                 _shardIds.swap(shardIds);
                 _shardVersions.swap(shardVersions);
                 _chunkRanges.reloadAll(_chunkMap);
+                _loadRoutingTable();
 
                 return;
             }
@@ -328,6 +329,21 @@ bool ChunkManager::_load(OperationContext* txn,
     }
 }
 
+void ChunkManager::_loadRoutingTable() {
+    vector<BSONObj> maxKeys;
+    vector<ChunkPtr> chunks;
+    maxKeys.reserve(_chunkMap.size());
+    chunks.reserve(_chunkMap.size());
+
+    for (const auto& chunkMapEntry : _chunkMap) {
+        maxKeys.push_back(chunkMapEntry.first);
+        chunks.push_back(chunkMapEntry.second);
+    }
+
+    _routingTable = ChunkRoutingTable(maxKeys);
+    _routingChunks.swap(chunks);
+}
+
 shared_ptr<ChunkManager> ChunkManager::reload(OperationContext* txn, bool force) const {
     const NamespaceString nss(_ns);
     auto config = uassertStatusOK(grid.catalogCache()->getDatabase(txn, nss.db().toString()));
@@ -449,10 +465,10 @@ ChunkPtr ChunkManager::findIntersectingChunk(OperationContext* txn, const BSONOb
         BSONObj chunkMin;
         ChunkPtr chunk;
         {
-            ChunkMap::const_iterator it = _chunkMap.upper_bound(shardKey);
-            if (it != _chunkMap.end()) {
-                chunkMin = it->first;
-                chunk = it->second;
+            const size_t pos = _routingTable.upperBound(shardKey);
+            if (pos != _routingChunks.size()) {
+                chunk = _routingChunks[pos];
+                chunkMin = chunk->getMax();
             }
         }
 
@@ -34,6 +34,7 @@
 
 #include "mongo/db/repl/optime.h"
 #include "mongo/s/chunk.h"
+#include "mongo/s/chunk_routing_table.h"
 #include "mongo/s/shard_key_pattern.h"
 #include "mongo/util/concurrency/ticketholder.h"
 
@@ -262,6 +263,9 @@ private:
                ShardVersionMap* shardVersions,
                const ChunkManager* oldManager);
 
+    // Rebuilds the routing table from the contents of _chunkMap
+    void _loadRoutingTable();
+
 
     // All members should be const for thread-safety
     const std::string _ns;
@@ -276,6 +280,11 @@ private:
     ChunkMap _chunkMap;
     ChunkRangeManager _chunkRanges;
 
+    // Flat index over the max keys of _chunkMap, used to target single shard keys. The chunk for
+    // the i-th key of _routingTable is _routingChunks[i].
+    ChunkRoutingTable _routingTable;
+    std::vector<ChunkPtr> _routingChunks;
+
     std::set<ShardId> _shardIds;
 
     // Max known version per shard
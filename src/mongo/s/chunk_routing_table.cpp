@@ -0,0 +1,89 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects
+ *    for all of the code used other than as permitted herein. If you modify
+ *    file(s) with this exception, you may extend this exception to your
+ *    version of the file(s), but you are not obligated to do so. If you do not
+ *    wish to do so, delete this exception statement from your version. If you
+ *    delete this exception statement from all source files in the program,
+ *    then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/chunk_routing_table.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "mongo/db/storage/key_string.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+namespace {
+
+// Shard key ranges compare as if every field of the shard key were ascending.
+const Ordering kAllAscending = Ordering::make(BSONObj());
+
+int compareEncoded(const char* lhs, size_t lhsSize, const char* rhs, size_t rhsSize) {
+    int cmp = memcmp(lhs, rhs, std::min(lhsSize, rhsSize));
+    if (cmp) {
+        return cmp;
+    }
+    return lhsSize < rhsSize ? -1 : (lhsSize > rhsSize ? 1 : 0);
+}
+
+}  // namespace
+
+ChunkRoutingTable::ChunkRoutingTable(const std::vector<BSONObj>& maxKeys) {
+    _offsets.reserve(maxKeys.size() + 1);
+    _offsets.push_back(0);
+
+    KeyString ks;
+    for (const auto& maxKey : maxKeys) {
+        ks.resetToKey(maxKey, kAllAscending);
+        _keys.insert(_keys.end(), ks.getBuffer(), ks.getBuffer() + ks.getSize());
+        invariant(_keys.size() <= std::numeric_limits<uint32_t>::max());
+        _offsets.push_back(_keys.size());
+    }
+}
+
+size_t ChunkRoutingTable::upperBound(const BSONObj& key) const {
+    const KeyString ks(key, kAllAscending);
+
+    size_t low = 0;
+    size_t high = size();
+    while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+        const char* bound = &_keys[_offsets[mid]];
+        const size_t boundSize = _offsets[mid + 1] - _offsets[mid];
+        if (compareEncoded(bound, boundSize, ks.getBuffer(), ks.getSize()) <= 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+}  // namespace mongo
@@ -0,0 +1,77 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects
+ *    for all of the code used other than as permitted herein. If you modify
+ *    file(s) with this exception, you may extend this exception to your
+ *    version of the file(s), but you are not obligated to do so. If you do not
+ *    wish to do so, delete this exception statement from your version. If you
+ *    delete this exception statement from all source files in the program,
+ *    then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+/**
+ * Immutable index over the upper bounds of a collection's chunks, used to find the chunk which
+ * owns a shard key without walking a tree of BSONObj keys.
+ *
+ * The bounds are stored in ascending order as KeyString encodings, packed back to back into a
+ * single buffer, so a lookup is a binary search doing memcmp over contiguous memory. Like the
+ * shard key ranges themselves, the bounds compare without regard to field names.
+ */
+class ChunkRoutingTable {
+public:
+    ChunkRoutingTable() = default;
+
+    /**
+     * Builds a table over 'maxKeys', which must be sorted in ascending order without duplicates.
+     */
+    explicit ChunkRoutingTable(const std::vector<BSONObj>& maxKeys);
+
+    /**
+     * Returns the position of the first bound which is greater than 'key', or size() if there is
+     * none. This is the position of the chunk whose range [min, max) may contain 'key'.
+     */
+    size_t upperBound(const BSONObj& key) const;
+
+    size_t size() const {
+        return _offsets.empty() ? 0 : _offsets.size() - 1;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+private:
+    // Concatenated KeyString encodings of each bound.
+    std::vector<char> _keys;
+
+    // The i-th bound occupies [_offsets[i], _offsets[i + 1]) of '_keys'.
+    std::vector<uint32_t> _offsets;
+};
+
+}  // namespace mongo
@@ -0,0 +1,111 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects
+ *    for all of the code used other than as permitted herein. If you modify
+ *    file(s) with this exception, you may extend this exception to your
+ *    version of the file(s), but you are not obligated to do so. If you do not
+ *    wish to do so, delete this exception statement from your version. If you
+ *    delete this exception statement from all source files in the program,
+ *    then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <map>
+#include <vector>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/platform/random.h"
+#include "mongo/s/chunk_routing_table.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using std::vector;
+
+TEST(ChunkRoutingTable, Empty) {
+    ChunkRoutingTable table;
+    ASSERT(table.empty());
+    ASSERT_EQ(0U, table.upperBound(BSON("a" << 1)));
+
+    ChunkRoutingTable builtEmpty{vector<BSONObj>()};
+    ASSERT(builtEmpty.empty());
+    ASSERT_EQ(0U, builtEmpty.upperBound(BSON("a" << 1)));
+}
+
+TEST(ChunkRoutingTable, UpperBoundIsChunkContainingKey) {
+    // Chunks [MinKey, 0), [0, 10), [10, 20), [20, MaxKey).
+    vector<BSONObj> maxKeys;
+    maxKeys.push_back(BSON("a" << 0));
+    maxKeys.push_back(BSON("a" << 10));
+    maxKeys.push_back(BSON("a" << 20));
+    maxKeys.push_back(BSON("a" << MAXKEY));
+    ChunkRoutingTable table(maxKeys);
+    ASSERT_EQ(4U, table.size());
+
+    ASSERT_EQ(0U, table.upperBound(BSON("a" << MINKEY)));
+    ASSERT_EQ(0U, table.upperBound(BSON("a" << -5)));
+    ASSERT_EQ(1U, table.upperBound(BSON("a" << 0)));
+    ASSERT_EQ(1U, table.upperBound(BSON("a" << 9.5)));
+    ASSERT_EQ(2U, table.upperBound(BSON("a" << 10LL)));
+    ASSERT_EQ(3U, table.upperBound(BSON("a" << 20)));
+    ASSERT_EQ(3U, table.upperBound(BSON("a" << "string")));
+    ASSERT_EQ(4U, table.upperBound(BSON("a" << MAXKEY)));
+}
+
+TEST(ChunkRoutingTable, CompoundKeys) {
+    vector<BSONObj> maxKeys;
+    maxKeys.push_back(BSON("a" << 1 << "b" << "x"));
+    maxKeys.push_back(BSON("a" << 1 << "b" << MAXKEY));
+    maxKeys.push_back(BSON("a" << MAXKEY << "b" << MAXKEY));
+    ChunkRoutingTable table(maxKeys);
+
+    ASSERT_EQ(0U, table.upperBound(BSON("a" << 1 << "b" << "w")));
+    ASSERT_EQ(1U, table.upperBound(BSON("a" << 1 << "b" << "x")));
+    ASSERT_EQ(0U, table.upperBound(BSON("a" << 1 << "b" << 5)));
+    ASSERT_EQ(2U, table.upperBound(BSON("a" << 2 << "b" << MINKEY)));
+}
+
+// The table must agree with the BSONObj-keyed map it replaces for targeting.
+TEST(ChunkRoutingTable, MatchesBSONObjMap) {
+    PseudoRandom random(1);
+
+    std::map<BSONObj, size_t, BSONObjCmp> boundsMap;
+    for (int i = 0; i < 1000; ++i) {
+        boundsMap.insert(std::make_pair(BSON("a" << random.nextInt32(100000)), 0));
+    }
+    boundsMap.insert(std::make_pair(BSON("a" << MAXKEY), 0));
+
+    vector<BSONObj> maxKeys;
+    for (auto& entry : boundsMap) {
+        entry.second = maxKeys.size();
+        maxKeys.push_back(entry.first);
+    }
+    ChunkRoutingTable table(maxKeys);
+
+    for (int i = 0; i < 10000; ++i) {
+        const BSONObj key = BSON("a" << random.nextInt32(100000));
+        ASSERT_EQ(boundsMap.upper_bound(key)->second, table.upperBound(key));
+    }
+}
+
+}  // namespace
+}  // namespace mongo
@@ -277,6 +277,7 @@ std::shared_ptr<ChunkManager> DBConfig::getChunkManager(OperationContext* txn,
     ChunkManagerPtr oldManager;
 
     const auto currentReloadIteration = _reloadCount.load();
+    const auto currentChunkManagerLoadIteration = _chunkManagerLoadCount.load();
 
     {
         stdx::lock_guard<stdx::mutex> lk(_lock);
@@ -340,10 +341,27 @@ std::shared_ptr<ChunkManager> DBConfig::getChunkManager(OperationContext* txn,
     // we are not locked now, and want to load a new ChunkManager
 
     unique_ptr<ChunkManager> tempChunkManager;
+    uint64_t chunkManagerLoadIteration;
 
     {
         stdx::lock_guard<stdx::mutex> lll(_hitConfigServerLock);
 
+        if (!forceReload) {
+            // If another thread loaded this collection while we were waiting for the lock, and
+            // its load started after this request was made, its result is at least as recent as
+            // anything we would get from the config server now.
+            stdx::lock_guard<stdx::mutex> lk(_lock);
+
+            CollectionInfo& ci = _collections[ns];
+
+            if (ci.isSharded() &&
+                ci.getChunkManagerLoadIteration() > currentChunkManagerLoadIteration) {
+                return ci.getCM();
+            }
+        }
+
+        chunkManagerLoadIteration = _chunkManagerLoadCount.addAndFetch(1);
+
         if (!newestChunk.empty() && !forceReload) {
             // If we have a target we're going for see if we've hit already
             stdx::lock_guard<stdx::mutex> lk(_lock);
@@ -420,6 +438,8 @@ std::shared_ptr<ChunkManager> DBConfig::getChunkManager(OperationContext* txn,
         }
     }
 
+    ci.setChunkManagerLoadIteration(chunkManagerLoadIteration);
+
     uassert(
         15883, str::stream() << "not sharded after chunk manager reset : " << ns, ci.isSharded());
 
@@ -89,6 +89,19 @@ struct CollectionInfo {
         return _configOpTime;
     }
 
+    /**
+     * Iteration of DBConfig's chunk manager load counter at which the chunks of this collection
+     * were last loaded from the config server, or 0 if they have not been since this entry was
+     * created.
+     */
+    uint64_t getChunkManagerLoadIteration() const {
+        return _chunkManagerLoadIteration;
+    }
+
+    void setChunkManagerLoadIteration(uint64_t loadIteration) {
+        _chunkManagerLoadIteration = std::max(_chunkManagerLoadIteration, loadIteration);
+    }
+
 private:
     BSONObj _key;
     bool _unique;
@@ -96,6 +109,7 @@ private:
     bool _dirty;
     bool _dropped;
     repl::OpTime _configOpTime;
+    uint64_t _chunkManagerLoadIteration{0};
 };
 
 /**
@@ -231,6 +245,11 @@ protected:
     // long time for very large clusters, this can be used to minimize duplicate work when multiple
     // threads tries to perform full rerload at roughly the same time.
     AtomicUInt64 _reloadCount;  // (S)
+
+    // Increments every time a thread starts loading the chunks of a collection. Lets threads which
+    // queued up behind _hitConfigServerLock for the same collection reuse the result of a load
+    // that started after their request, instead of each hitting the config server in turn.
+    AtomicUInt64 _chunkManagerLoadCount;  // (S)
 };
 
 
@@ -82,6 +82,15 @@ public:
      */
     virtual long long getNumReturnedSoFar() const = 0;
 
+    /**
+     * Returns whether this cursor has already merged as many results as its limit allows and has
+     * handed all of them out via next(). Once true, next() can only return end-of-stream, so the
+     * remote cursors may be closed without waiting for another call to next().
+     *
+     * Always false for tailable cursors, which stay open at end-of-stream.
+     */
+    virtual bool isLimitReached() const = 0;
+
     /**
      * Stash the BSONObj so that it gets returned from the CCC on a later call to next().
      *
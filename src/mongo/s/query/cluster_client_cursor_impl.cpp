@@ -77,11 +77,25 @@ ClusterClientCursorGuard ClusterClientCursorImpl::make(executor::TaskExecutor* e
 
 ClusterClientCursorImpl::ClusterClientCursorImpl(executor::TaskExecutor* executor,
                                                  ClusterClientCursorParams&& params)
-    : _isTailable(params.isTailable), _root(buildMergerPlan(executor, std::move(params))) {}
+    : _isTailable(params.isTailable),
+      _limit(params.limit),
+      _root(buildMergerPlan(executor, std::move(params))) {}
 
 ClusterClientCursorImpl::ClusterClientCursorImpl(std::unique_ptr<RouterStageMock> root)
     : _root(std::move(root)) {}
 
+ClusterClientCursorImpl::ClusterClientCursorImpl(std::unique_ptr<RouterStageMock> root,
+                                                 ClusterClientCursorParams&& params)
+    : _isTailable(params.isTailable), _limit(params.limit), _root(std::move(root)) {
+    if (params.skip) {
+        _root = stdx::make_unique<RouterStageSkip>(std::move(_root), *params.skip);
+    }
+
+    if (params.limit) {
+        _root = stdx::make_unique<RouterStageLimit>(std::move(_root), *params.limit);
+    }
+}
+
 StatusWith<boost::optional<BSONObj>> ClusterClientCursorImpl::next() {
     // First return stashed results, if there are any.
     if (!_stash.empty()) {
@@ -94,6 +108,7 @@ StatusWith<boost::optional<BSONObj>> ClusterClientCursorImpl::next() {
     auto next = _root->next();
     if (next.isOK() && next.getValue()) {
         ++_numReturnedSoFar;
+        ++_numMergedSoFar;
     }
     return next;
 }
@@ -110,6 +125,10 @@ long long ClusterClientCursorImpl::getNumReturnedSoFar() const {
     return _numReturnedSoFar;
 }
 
+bool ClusterClientCursorImpl::isLimitReached() const {
+    return !_isTailable && _limit && _stash.empty() && _numMergedSoFar >= *_limit;
+}
+
 void ClusterClientCursorImpl::queueResult(const BSONObj& obj) {
     invariant(obj.isOwned());
     _stash.push(obj);
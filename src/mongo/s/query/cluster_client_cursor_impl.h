@@ -96,6 +96,13 @@ public:
      */
     ClusterClientCursorImpl(std::unique_ptr<RouterStageMock> root);
 
+    /**
+     * Constructs a CCC whose result set is generated by a mock execution stage. The skip and limit
+     * in 'params' are applied on top of 'root', in the same way as on top of the merge stage.
+     */
+    ClusterClientCursorImpl(std::unique_ptr<RouterStageMock> root,
+                            ClusterClientCursorParams&& params);
+
     StatusWith<boost::optional<BSONObj>> next() final;
 
     void kill() final;
@@ -104,6 +111,8 @@ public:
 
     long long getNumReturnedSoFar() const final;
 
+    bool isLimitReached() const final;
+
     void queueResult(const BSONObj& obj) final;
 
     bool remotesExhausted() final;
@@ -124,9 +133,16 @@ private:
 
     bool _isTailable = false;
 
+    // The limit applied by the merger plan, if any.
+    boost::optional<long long> _limit;
+
     // Number of documents already returned by next().
     long long _numReturnedSoFar = 0;
 
+    // Number of documents produced by '_root'. Unlike '_numReturnedSoFar', documents which are
+    // handed back through queueResult() and returned again are not counted twice.
+    long long _numMergedSoFar = 0;
+
     // The root stage of the pipeline used to return the result set, merged from the remote nodes.
     std::unique_ptr<RouterExecStage> _root;
 
@@ -32,6 +32,7 @@
 
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/namespace_string.h"
 #include "mongo/s/query/router_stage_mock.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/unittest/unittest.h"
@@ -142,6 +143,117 @@ TEST(ClusterClientCursorImpl, ForwardsAwaitDataTimeout) {
     ASSERT_EQ(789, durationCount<Milliseconds>(awaitDataTimeout.getValue()));
 }
 
+ClusterClientCursorParams makeParams(boost::optional<long long> skip,
+                                     boost::optional<long long> limit,
+                                     bool isTailable = false) {
+    ClusterClientCursorParams params(NamespaceString("testdb.testcoll"));
+    params.skip = skip;
+    params.limit = limit;
+    params.isTailable = isTailable;
+    return params;
+}
+
+TEST(ClusterClientCursorImpl, LimitNotReachedWithoutLimit) {
+    auto mockStage = stdx::make_unique<RouterStageMock>();
+    mockStage->queueResult(BSON("a" << 1));
+
+    ClusterClientCursorImpl cursor(std::move(mockStage));
+    ASSERT_FALSE(cursor.isLimitReached());
+
+    auto result = cursor.next();
+    ASSERT_OK(result.getStatus());
+    ASSERT(result.getValue());
+    ASSERT_FALSE(cursor.isLimitReached());
+}
+
+TEST(ClusterClientCursorImpl, LimitReachedAtEndOfBatch) {
+    auto mockStage = stdx::make_unique<RouterStageMock>();
+    for (int i = 1; i <= 5; ++i) {
+        mockStage->queueResult(BSON("a" << i));
+    }
+
+    ClusterClientCursorImpl cursor(std::move(mockStage), makeParams(boost::none, 3LL));
+
+    for (int i = 1; i <= 3; ++i) {
+        ASSERT_FALSE(cursor.isLimitReached());
+        auto result = cursor.next();
+        ASSERT_OK(result.getStatus());
+        ASSERT(result.getValue());
+        ASSERT_EQ(*result.getValue(), BSON("a" << i));
+    }
+
+    // The last document allowed by the limit has been returned, so the limit is reached before
+    // next() is asked for end-of-stream.
+    ASSERT_TRUE(cursor.isLimitReached());
+
+    auto result = cursor.next();
+    ASSERT_OK(result.getStatus());
+    ASSERT_FALSE(result.getValue());
+    ASSERT_TRUE(cursor.isLimitReached());
+}
+
+TEST(ClusterClientCursorImpl, LimitNotReachedWhileResultIsQueued) {
+    auto mockStage = stdx::make_unique<RouterStageMock>();
+    mockStage->queueResult(BSON("a" << 1));
+    mockStage->queueResult(BSON("a" << 2));
+
+    ClusterClientCursorImpl cursor(std::move(mockStage), makeParams(boost::none, 2LL));
+
+    ASSERT_OK(cursor.next().getStatus());
+    auto secondResult = cursor.next();
+    ASSERT_OK(secondResult.getStatus());
+    ASSERT(secondResult.getValue());
+    ASSERT_TRUE(cursor.isLimitReached());
+
+    // Stash the last result, as a find does when it does not fit in the batch. It has not been
+    // handed out yet, so the limit is not reached.
+    cursor.queueResult(secondResult.getValue()->getOwned());
+    ASSERT_FALSE(cursor.isLimitReached());
+
+    auto stashedResult = cursor.next();
+    ASSERT_OK(stashedResult.getStatus());
+    ASSERT(stashedResult.getValue());
+    ASSERT_EQ(*stashedResult.getValue(), BSON("a" << 2));
+    ASSERT_TRUE(cursor.isLimitReached());
+    ASSERT_EQ(cursor.getNumReturnedSoFar(), 3LL);
+}
+
+TEST(ClusterClientCursorImpl, LimitNeverReachedForTailableCursor) {
+    auto mockStage = stdx::make_unique<RouterStageMock>();
+    mockStage->queueResult(BSON("a" << 1));
+    mockStage->queueResult(BSON("a" << 2));
+
+    ClusterClientCursorImpl cursor(std::move(mockStage), makeParams(boost::none, 1LL, true));
+    ASSERT_TRUE(cursor.isTailable());
+
+    auto result = cursor.next();
+    ASSERT_OK(result.getStatus());
+    ASSERT(result.getValue());
+    ASSERT_FALSE(cursor.isLimitReached());
+}
+
+TEST(ClusterClientCursorImpl, LimitReachedAfterSkip) {
+    auto mockStage = stdx::make_unique<RouterStageMock>();
+    for (int i = 1; i <= 5; ++i) {
+        mockStage->queueResult(BSON("a" << i));
+    }
+
+    ClusterClientCursorImpl cursor(std::move(mockStage), makeParams(2LL, 2LL));
+
+    // Skipped documents do not count towards the limit.
+    auto firstResult = cursor.next();
+    ASSERT_OK(firstResult.getStatus());
+    ASSERT(firstResult.getValue());
+    ASSERT_EQ(*firstResult.getValue(), BSON("a" << 3));
+    ASSERT_FALSE(cursor.isLimitReached());
+
+    auto secondResult = cursor.next();
+    ASSERT_OK(secondResult.getStatus());
+    ASSERT(secondResult.getValue());
+    ASSERT_EQ(*secondResult.getValue(), BSON("a" << 4));
+    ASSERT_TRUE(cursor.isLimitReached());
+}
+
 }  // namespace
 
 }  // namespace mongo
@@ -66,6 +66,10 @@ long long ClusterClientCursorMock::getNumReturnedSoFar() const {
     return _numReturnedSoFar;
 }
 
+bool ClusterClientCursorMock::isLimitReached() const {
+    return false;
+}
+
 void ClusterClientCursorMock::kill() {
     _killed = true;
     if (_killCallback) {
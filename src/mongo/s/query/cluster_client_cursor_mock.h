@@ -51,6 +51,8 @@ public:
 
     long long getNumReturnedSoFar() const final;
 
+    bool isLimitReached() const final;
+
     void queueResult(const BSONObj& obj) final;
 
     Status setAwaitDataTimeout(Milliseconds awaitDataTimeout) final;
@@ -124,6 +124,11 @@ bool ClusterCursorManager::PinnedCursor::isTailable() const {
     return _cursor->isTailable();
 }
 
+bool ClusterCursorManager::PinnedCursor::isLimitReached() const {
+    invariant(_cursor);
+    return _cursor->isLimitReached();
+}
+
 void ClusterCursorManager::PinnedCursor::returnCursor(CursorState cursorState) {
     invariant(_cursor);
     // Note that unpinning a cursor transfers ownership of the underlying ClusterClientCursor object
@@ -161,6 +161,12 @@ public:
          */
         bool isTailable() const;
 
+        /**
+         * Returns whether the underlying cursor has already returned every result permitted by its
+         * limit. Cannot be called after returnCursor() is called. A cursor must be owned.
+         */
+        bool isLimitReached() const;
+
         /**
          * Transfers ownership of the underlying cursor back to the manager.  A cursor must be
          * owned, and a cursor will no longer be owned after this method completes.
@@ -40,6 +40,7 @@
 #include "mongo/client/connpool.h"
 #include "mongo/client/read_preference.h"
 #include "mongo/db/commands.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/getmore_request.h"
@@ -72,6 +73,12 @@ static const BSONObj kSortKeyMetaProjection = BSON("$meta"
 // more than 8 decimal digits since the response is at most 16MB, and 16 * 1024 * 1024 < 1 * 10^8.
 static const int kPerDocumentOverheadBytesUpperBound = 10;
 
+// Number of cursors whose remote cursors were closed as soon as the query's limit was satisfied,
+// rather than on a subsequent getMore which could only have returned end-of-stream.
+Counter64 cursorsClosedAtLimit;
+ServerStatusMetricField<Counter64> displayCursorsClosedAtLimit("query.cursorsClosedAtLimit",
+                                                               &cursorsClosedAtLimit);
+
 /**
  * Given the LiteParsedQuery 'lpq' being executed by mongos, returns a copy of the query which is
  * suitable for forwarding to the targeted hosts.
@@ -321,6 +328,14 @@ StatusWith<CursorId> runQueryWithoutRetrying(OperationContext* txn,
         cursorState = ClusterCursorManager::CursorState::Exhausted;
     }
 
+    // If the first batch already holds every result allowed by the limit, close the remote cursors
+    // now. Otherwise the shards would keep their cursors (and any prefetched batches) open until
+    // the client issues a getMore that can only return end-of-stream.
+    if (cursorState == ClusterCursorManager::CursorState::NotExhausted && ccc->isLimitReached()) {
+        cursorState = ClusterCursorManager::CursorState::Exhausted;
+        cursorsClosedAtLimit.increment();
+    }
+
     // If the cursor is exhausted, then there are no more results to return and we don't need to
     // allocate a cursor id.
     if (cursorState == ClusterCursorManager::CursorState::Exhausted) {
@@ -462,6 +477,12 @@ StatusWith<CursorResponse> ClusterFind::runGetMore(OperationContext* txn,
         batch.push_back(std::move(*next.getValue()));
     }
 
+    if (cursorState == ClusterCursorManager::CursorState::NotExhausted &&
+        pinnedCursor.getValue().isLimitReached()) {
+        cursorState = ClusterCursorManager::CursorState::Exhausted;
+        cursorsClosedAtLimit.increment();
+    }
+
     // Transfer ownership of the cursor back to the cursor manager.
     pinnedCursor.getValue().returnCursor(cursorState);
 